@@ -7,6 +7,7 @@ FSVONavigationQueryFilterSettings::FSVONavigationQueryFilterSettings() :
     HeuristicScale( 1.0f ),
     bUseNodeSizeCompensation( true ),
     bSmoothPaths( true ),
-    SmoothingSubdivisions( 10 )
+    SmoothingSubdivisions( 10 ),
+    MinimumClearance( 0.0f )
 {
 }
@@ -48,11 +48,28 @@ ENavigationQueryResult::Type FSVOPathFinder::GetPath( FSVONavigationPath & navig
 {
     if ( const auto * volume_navigation_data = navigation_data.GetVolumeNavigationDataContainingPoints( { start_location, end_location } ) )
     {
+        const auto volume_navigation_query_filter = volume_navigation_data->GetVolumeNavigationQueryFilter();
+
+        const auto navigation_query_filter_copy = volume_navigation_query_filter != nullptr
+                                                      ? volume_navigation_query_filter.GetDefaultObject()->GetQueryFilter( navigation_data, nullptr )
+                                                      : nav_query_filter;
+
+        // The direct path is only blocked by the collision channels of the query filter, like the paths of the algorithms
+        auto collision_channel_mask = MAX_uint32;
+
+        if ( navigation_query_filter_copy.IsValid() )
+        {
+            if ( const auto * query_filter_implementation = static_cast< const FSVONavigationQueryFilterImpl * >( navigation_query_filter_copy->GetImplementation() ) )
+            {
+                collision_channel_mask = volume_navigation_data->GetCollisionChannelMask( query_filter_implementation->QueryFilterSettings.CollisionChannels );
+            }
+        }
+
         if ( auto * settings = GetDefault< USVONavigationSettings >() )
         {
             if ( settings->DefaultRaycasterClass != nullptr )
             {
-                if ( !settings->DefaultRaycasterClass->GetDefaultObject< USVORayCaster >()->Trace( *volume_navigation_data, start_location, end_location ) )
+                if ( !settings->DefaultRaycasterClass->GetDefaultObject< USVORayCaster >()->Trace( *volume_navigation_data, start_location, end_location, collision_channel_mask ) )
                 {
                     auto & path_points = navigation_path.GetPathPoints();
                     path_points.Emplace( start_location );
@@ -64,12 +81,6 @@ ENavigationQueryResult::Type FSVOPathFinder::GetPath( FSVONavigationPath & navig
             }
         }
 
-        const auto volume_navigation_query_filter = volume_navigation_data->GetVolumeNavigationQueryFilter();
-
-        const auto navigation_query_filter_copy = volume_navigation_query_filter != nullptr
-                                                      ? volume_navigation_query_filter.GetDefaultObject()->GetQueryFilter( navigation_data, nullptr )
-                                                      : nav_query_filter;
-
         if ( const auto * path_finder = GetPathFindingAlgorithm( navigation_query_filter_copy ) )
         {
             const auto params = FSVOPathFindingParameters::Initialize( *volume_navigation_data, start_location, end_location, *navigation_query_filter_copy );
@@ -58,7 +58,8 @@ FSVOPathFindingParameters::FSVOPathFindingParameters( const FSVOVolumeNavigation
     QueryFilterSettings( QueryFilterImplementation->QueryFilterSettings ),
     HeuristicCalculator( QueryFilterSettings.HeuristicCalculator ),
     CostCalculator( QueryFilterSettings.TraversalCostCalculator ),
-    VolumeNavigationData( volume_navigation_data )
+    VolumeNavigationData( volume_navigation_data ),
+    CollisionChannelMask( volume_navigation_data.GetCollisionChannelMask( QueryFilterSettings.CollisionChannels ) )
 {
 }
 
@@ -66,9 +67,9 @@ TOptional< FSVOPathFindingParameters > FSVOPathFindingParameters::Initialize( co
 {
     auto result = FSVOPathFindingParameters( volume_navigation_data, start_location, end_location, nav_query_filter );
 
-    if ( volume_navigation_data.GetNodeAddressFromPosition( result.StartNodeAddress, start_location ) )
+    if ( volume_navigation_data.GetNodeAddressFromPosition( result.StartNodeAddress, start_location, result.CollisionChannelMask ) )
     {
-        if ( volume_navigation_data.GetNodeAddressFromPosition( result.EndNodeAddress, end_location ) )
+        if ( volume_navigation_data.GetNodeAddressFromPosition( result.EndNodeAddress, end_location, result.CollisionChannelMask ) )
         {
             return result;
         }
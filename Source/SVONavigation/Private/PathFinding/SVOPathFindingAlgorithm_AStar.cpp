@@ -96,7 +96,15 @@ ESVOPathFindingAlgorithmStepperStatus FSVOPathFindingAlgorithmStepper_AStar::Ini
 void FSVOPathFindingAlgorithmStepper_AStar::FillNodeAddressNeighbors( const FSVONodeAddress & node_address )
 {
     Neighbors.Reset();
-    Graph.Graph.GetNodeNeighbors( Neighbors, node_address );
+    Graph.Graph.GetNodeNeighbors( Neighbors, node_address, Parameters.CollisionChannelMask );
+
+    if ( Parameters.QueryFilterSettings.MinimumClearance > 0.0f )
+    {
+        Neighbors.RemoveAll( [ this ]( const FSVONodeAddress & neighbor_address ) {
+            return neighbor_address.IsValid() && Parameters.VolumeNavigationData.GetNodeClearanceFromAddress( neighbor_address ) < Parameters.QueryFilterSettings.MinimumClearance;
+        } );
+    }
+
     NeighborIndex = 0;
 }
 
@@ -154,7 +154,7 @@ bool FSVOPathFindingAlgorithmStepper_ThetaStar::HasLineOfSight( const FSVONodeAd
     const auto from_position = get_adjusted_position( from );
     const auto to_position = get_adjusted_position( to );
 
-    const auto result = !ray_caster->Trace( Parameters.VolumeNavigationData, from_position, to_position );
+    const auto result = !ray_caster->Trace( Parameters.VolumeNavigationData, from_position, to_position, Parameters.CollisionChannelMask );
 
 
     return result;
@@ -20,3 +20,25 @@ float USVOPathCostCalculator_Fixed::GetTraversalCost( const FSVOVolumeNavigation
 {
     return Cost;
 }
+
+USVOPathCostCalculator_Clearance::USVOPathCostCalculator_Clearance() :
+    PreferredClearance( 200.0f ),
+    MaxCostMultiplier( 4.0f )
+{
+}
+
+float USVOPathCostCalculator_Clearance::GetTraversalCost( const FSVOVolumeNavigationData & bounds_data, const FSVONodeAddress & start, const FSVONodeAddress & end ) const
+{
+    const auto start_location = bounds_data.GetNodePositionFromAddress( start, true );
+    const auto end_location = bounds_data.GetNodePositionFromAddress( end, true );
+    const auto distance = ( start_location - end_location ).Size();
+
+    if ( PreferredClearance <= 0.0f )
+    {
+        return distance;
+    }
+
+    const auto clearance_ratio = FMath::Clamp( bounds_data.GetNodeClearanceFromAddress( end ) / PreferredClearance, 0.0f, 1.0f );
+
+    return distance * FMath::Lerp( MaxCostMultiplier, 1.0f, clearance_ratio );
+}
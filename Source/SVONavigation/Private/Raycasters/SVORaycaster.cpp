@@ -36,14 +36,14 @@ void FSVORayCasterObserver_GenerateDebugInfos::AddTraversedLeafSubNode( FSVONode
     DebugInfos.TraversedLeafSubNodes.Emplace( node_address, is_occluded );
 }
 
-bool USVORayCaster::Trace( const FSVOVolumeNavigationData & volume_navigation_data, const FVector & from, const FVector & to ) const
+bool USVORayCaster::Trace( const FSVOVolumeNavigationData & volume_navigation_data, const FVector & from, const FVector & to, const uint32 channel_mask ) const
 {
     if ( Observer.IsValid() )
     {
         Observer->Initialize( &volume_navigation_data, from, to );
     }
 
-    const auto result = TraceInternal( volume_navigation_data, from, to );
+    const auto result = TraceInternal( volume_navigation_data, from, to, channel_mask );
 
     if ( Observer.IsValid() )
     {
@@ -58,7 +58,7 @@ void USVORayCaster::SetObserver( const TSharedPtr< FSVORayCasterObserver > obser
     Observer = observer;
 }
 
-bool USVORayCaster::TraceInternal( const FSVOVolumeNavigationData & volume_navigation_data, const FVector & from, const FVector & to ) const
+bool USVORayCaster::TraceInternal( const FSVOVolumeNavigationData & volume_navigation_data, const FVector & from, const FVector & to, const uint32 channel_mask ) const
 {
     return false;
 }
@@ -79,12 +79,39 @@ which in this case returns 20 as expected.
 From there we can apply the rules of the algorithm to know which of the neighbor sub nodes to test.
 */
 
-bool USVORayCaster_OctreeTraversal::TraceInternal( const FSVOVolumeNavigationData & volume_navigation_data, const FVector & from, const FVector & to ) const
+bool USVORayCaster_OctreeTraversal::TraceInternal( const FSVOVolumeNavigationData & volume_navigation_data, const FVector & from, const FVector & to, const uint32 channel_mask ) const
+{
+    ChannelMask = channel_mask;
+
+    const auto & data = volume_navigation_data.GetData();
+    const LayerIndex top_layer_index = data.GetLayerCount() - 1;
+    const auto & top_layer = data.GetLayer( top_layer_index );
+
+    // A ray which misses the navigation bounds is blocked
+    auto result = !FMath::LineBoxIntersection( volume_navigation_data.GetNavigationBounds(), from, to, to - from );
+
+    // The algorithm works on a single cube, so the roots of the grid are traversed one after the other
+    for ( NodeIndex node_index = 0; node_index < static_cast< uint32 >( top_layer.GetNodeCount() ) && !result; ++node_index )
+    {
+        const FSVONodeAddress root_address( top_layer_index, node_index );
+        const auto root_bounds = FBox::BuildAABB( volume_navigation_data.GetNodePositionFromAddress( root_address, false ), FVector( top_layer.GetNodeExtent() ) );
+
+        result = DoesRayIntersectOccludedRoot( root_address, root_bounds, from, to, volume_navigation_data );
+    }
+
+    if ( bShowLineOfSightTraces )
+    {
+        DrawDebugLine( GetWorldContext(), from, to, result ? FColor::Red : FColor::Green, false, 5.0f );
+    }
+
+    return result;
+}
+
+bool USVORayCaster_OctreeTraversal::DoesRayIntersectOccludedRoot( const FSVONodeAddress & root_address, const FBox & root_bounds, const FVector & from, const FVector & to, const FSVOVolumeNavigationData & data ) const
 {
-    const auto & navigation_bounds = volume_navigation_data.GetNavigationBounds();
     FVector volume_center;
     FVector volume_extent;
-    navigation_bounds.GetCenterAndExtents( volume_center, volume_extent );
+    root_bounds.GetCenterAndExtents( volume_center, volume_extent );
 
     const FVector from_to( to - from );
     FRay ray( from, from_to );
@@ -133,26 +160,19 @@ bool USVORayCaster_OctreeTraversal::TraceInternal( const FSVOVolumeNavigationDat
     const auto div_z = 1.0f / ray.Direction.Z;
 
     const FOctreeRay octree_ray(
-        ( navigation_bounds.Min.X - ray.Origin.X ) * div_x,
-        ( navigation_bounds.Max.X - ray.Origin.X ) * div_x,
-        ( navigation_bounds.Min.Y - ray.Origin.Y ) * div_y,
-        ( navigation_bounds.Max.Y - ray.Origin.Y ) * div_y,
-        ( navigation_bounds.Min.Z - ray.Origin.Z ) * div_z,
-        ( navigation_bounds.Max.Z - ray.Origin.Z ) * div_z );
+        ( root_bounds.Min.X - ray.Origin.X ) * div_x,
+        ( root_bounds.Max.X - ray.Origin.X ) * div_x,
+        ( root_bounds.Min.Y - ray.Origin.Y ) * div_y,
+        ( root_bounds.Max.Y - ray.Origin.Y ) * div_y,
+        ( root_bounds.Min.Z - ray.Origin.Z ) * div_z,
+        ( root_bounds.Max.Z - ray.Origin.Z ) * div_z );
 
     if ( !octree_ray.Intersects() )
     {
-        return true;
-    }
-
-    const auto result = DoesRayIntersectOccludedNode( octree_ray, FSVONodeAddress( volume_navigation_data.GetData().GetLayerCount() - 1, 0 ), FSVONodeAddress::InvalidAddress, volume_navigation_data );
-
-    if ( bShowLineOfSightTraces )
-    {
-        DrawDebugLine( GetWorldContext(), from, to, result ? FColor::Red : FColor::Green, false, 5.0f );
+        return false;
     }
 
-    return result;
+    return DoesRayIntersectOccludedNode( octree_ray, root_address, FSVONodeAddress::InvalidAddress, data );
 }
 
 USVORayCaster_OctreeTraversal::FOctreeRay::FOctreeRay( const float tx0, const float tx1, const float ty0, const float ty1, const float tz0, const float tz1 ) :
@@ -256,7 +276,7 @@ bool USVORayCaster_OctreeTraversal::DoesRayIntersectOccludedSubNode( const FOctr
         return false;
     }
 
-    const auto & leaf_node = data.GetData().GetLeafNodes().GetLeafNode( node_address.NodeIndex );
+    const auto leaf_node = data.GetLeafNodeForChannels( node_address.NodeIndex, ChannelMask );
     int32 current_child_idx = GetFirstNodeIndex( FOctreeRay( ray.tx0, ray.txm, ray.ty0, ray.tym, ray.tz0, ray.tzm ) );
 
     bool result = false;
@@ -392,7 +412,7 @@ bool USVORayCaster_OctreeTraversal::DoesRayIntersectOccludedSubNode( const FOctr
 bool USVORayCaster_OctreeTraversal::DoesRayIntersectOccludedLeaf( const FOctreeRay & ray, const FSVONodeAddress & node_address, const FSVOVolumeNavigationData & data ) const
 {
     const auto node_index = node_address.NodeIndex;
-    const FSVOLeafNode & leaf_node = data.GetData().GetLeafNodes().GetLeafNode( node_index );
+    const auto leaf_node = data.GetLeafNodeForChannels( node_index, ChannelMask );
 
     if ( leaf_node.IsCompletelyFree() )
     {
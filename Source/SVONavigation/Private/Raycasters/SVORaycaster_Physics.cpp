@@ -4,7 +4,7 @@
 
 #include <Kismet/KismetSystemLibrary.h>
 
-bool USVORayCaster_PhysicsBase::TraceInternal( const FSVOVolumeNavigationData & volume_navigation_data, const FVector & from, const FVector & to ) const
+bool USVORayCaster_PhysicsBase::TraceInternal( const FSVOVolumeNavigationData & volume_navigation_data, const FVector & from, const FVector & to, const uint32 channel_mask ) const
 {
     return TracePhysicsInternal( from, to );
 }
@@ -0,0 +1,549 @@
+#include "SVOCollisionGeometrySnapshot.h"
+
+#include <Components/PrimitiveComponent.h>
+#include <Engine/World.h>
+#include <Interfaces/Interface_CollisionDataProvider.h>
+#include <PhysicsEngine/BodySetup.h>
+
+namespace
+{
+    constexpr int32 MaxGridCellsPerAxis = 32;
+    constexpr int32 CapsuleDistanceIterationCount = 24;
+
+    // Corners are indexed with bit 0 for X, bit 1 for Y and bit 2 for Z
+    const TArray< int32 > BoxTriangleIndices = {
+        0, 4, 6, 0, 6, 2, // -X
+        1, 3, 7, 1, 7, 5, // +X
+        0, 1, 5, 0, 5, 4, // -Y
+        2, 6, 7, 2, 7, 3, // +Y
+        0, 2, 3, 0, 3, 1, // -Z
+        4, 5, 7, 4, 7, 6  // +Z
+    };
+
+    bool IsSeparatingAxis( const FVector & axis, const FVector & v0, const FVector & v1, const FVector & v2, const FVector & box_extent )
+    {
+        const auto p0 = FVector::DotProduct( v0, axis );
+        const auto p1 = FVector::DotProduct( v1, axis );
+        const auto p2 = FVector::DotProduct( v2, axis );
+        const auto radius = box_extent.X * FMath::Abs( axis.X ) + box_extent.Y * FMath::Abs( axis.Y ) + box_extent.Z * FMath::Abs( axis.Z );
+
+        return FMath::Min3( p0, p1, p2 ) > radius || FMath::Max3( p0, p1, p2 ) < -radius;
+    }
+
+    // Separating axis test from "Fast 3D Triangle-Box Overlap Testing" (Tomas Akenine-Möller)
+    bool DoesTriangleOverlapBox( const FVector & a, const FVector & b, const FVector & c, const FVector & box_center, const FVector & box_extent )
+    {
+        const auto v0 = a - box_center;
+        const auto v1 = b - box_center;
+        const auto v2 = c - box_center;
+
+        // The 3 axes of the box
+        if ( FMath::Min3( v0.X, v1.X, v2.X ) > box_extent.X || FMath::Max3( v0.X, v1.X, v2.X ) < -box_extent.X ||
+             FMath::Min3( v0.Y, v1.Y, v2.Y ) > box_extent.Y || FMath::Max3( v0.Y, v1.Y, v2.Y ) < -box_extent.Y ||
+             FMath::Min3( v0.Z, v1.Z, v2.Z ) > box_extent.Z || FMath::Max3( v0.Z, v1.Z, v2.Z ) < -box_extent.Z )
+        {
+            return false;
+        }
+
+        const FVector edges[ 3 ] = { v1 - v0, v2 - v1, v0 - v2 };
+
+        // The normal of the triangle
+        if ( IsSeparatingAxis( FVector::CrossProduct( edges[ 0 ], edges[ 1 ] ), v0, v1, v2, box_extent ) )
+        {
+            return false;
+        }
+
+        // The 9 cross products of the axes of the box with the edges of the triangle
+        for ( const auto & edge : edges )
+        {
+            if ( IsSeparatingAxis( FVector( 0.0f, -edge.Z, edge.Y ), v0, v1, v2, box_extent ) ||
+                 IsSeparatingAxis( FVector( edge.Z, 0.0f, -edge.X ), v0, v1, v2, box_extent ) ||
+                 IsSeparatingAxis( FVector( -edge.Y, edge.X, 0.0f ), v0, v1, v2, box_extent ) )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+FSVOCollisionGeometrySnapshot::FSVOCollisionGeometrySnapshot() :
+    GridBounds( ForceInit ),
+    GridSize( FIntVector::ZeroValue ),
+    GridCellSize( 0.0f )
+{
+}
+
+void FSVOCollisionGeometrySnapshot::Gather( const UWorld & world, const FBox & bounds, const FSVODataGenerationSettings & generation_settings )
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOCollisionGeometrySnapshot_Gather );
+
+    check( IsInGameThread() );
+
+    Shapes.Reset();
+    TriangleVertices.Reset();
+    Planes.Reset();
+
+    TArray< const UPrimitiveComponent * > primitive_components;
+    GatherPrimitiveComponents( primitive_components, world, bounds, generation_settings );
+
+    for ( const auto * primitive_component : primitive_components )
+    {
+        if ( const auto * body_setup = const_cast< UPrimitiveComponent * >( primitive_component )->GetBodySetup() )
+        {
+            AddBodySetup( *body_setup, primitive_component->GetComponentTransform() );
+        }
+    }
+
+    BuildGrid();
+}
+
+bool FSVOCollisionGeometrySnapshot::IsBoxOccluded( const FBox & box ) const
+{
+    if ( Shapes.Num() == 0 || !box.Intersect( GridBounds ) )
+    {
+        return false;
+    }
+
+    FVector box_center;
+    FVector box_extent;
+    box.GetCenterAndExtents( box_center, box_extent );
+
+    const auto test_shape = [ & ]( const FShape & shape ) {
+        return shape.Bounds.Intersect( box ) && DoesShapeOverlapBox( shape, box_center, box_extent );
+    };
+
+    const auto get_cell_coords = [ this ]( const FVector & position ) {
+        const auto local_position = ( position - GridBounds.Min ) / GridCellSize;
+        return FIntVector(
+            FMath::Clamp( FMath::FloorToInt( local_position.X ), 0, GridSize.X - 1 ),
+            FMath::Clamp( FMath::FloorToInt( local_position.Y ), 0, GridSize.Y - 1 ),
+            FMath::Clamp( FMath::FloorToInt( local_position.Z ), 0, GridSize.Z - 1 ) );
+    };
+
+    const auto min_cell_coords = get_cell_coords( box.Min );
+    const auto max_cell_coords = get_cell_coords( box.Max );
+    const auto cell_count = ( max_cell_coords.X - min_cell_coords.X + 1 ) * ( max_cell_coords.Y - min_cell_coords.Y + 1 ) * ( max_cell_coords.Z - min_cell_coords.Z + 1 );
+
+    // Big boxes would test the same shapes in a lot of cells, so it's faster to test each shape once
+    if ( cell_count > Shapes.Num() )
+    {
+        return Shapes.FindByPredicate( test_shape ) != nullptr;
+    }
+
+    for ( auto z = min_cell_coords.Z; z <= max_cell_coords.Z; ++z )
+    {
+        for ( auto y = min_cell_coords.Y; y <= max_cell_coords.Y; ++y )
+        {
+            for ( auto x = min_cell_coords.X; x <= max_cell_coords.X; ++x )
+            {
+                const auto cell_index = x + GridSize.X * ( y + GridSize.Y * z );
+
+                for ( auto index = GridCellFirstShapeIndices[ cell_index ]; index < GridCellFirstShapeIndices[ cell_index + 1 ]; ++index )
+                {
+                    if ( test_shape( Shapes[ GridCellShapeIndices[ index ] ] ) )
+                    {
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+int FSVOCollisionGeometrySnapshot::GetAllocatedSize() const
+{
+    return Shapes.GetAllocatedSize() + TriangleVertices.GetAllocatedSize() + Planes.GetAllocatedSize() + GridCellFirstShapeIndices.GetAllocatedSize() + GridCellShapeIndices.GetAllocatedSize();
+}
+
+void FSVOCollisionGeometrySnapshot::GatherPrimitiveComponents( TArray< const UPrimitiveComponent * > & primitive_components, const UWorld & world, const FBox & bounds, const FSVODataGenerationSettings & generation_settings )
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOCollisionGeometrySnapshot_GatherPrimitiveComponents );
+
+    // Same queries as FSVOVolumeNavigationData::IsPositionOccluded, but over the whole bounds, so only the primitives the physics scene finds around the bounds are visited
+    const auto collision_shape = FCollisionShape::MakeBox( bounds.GetExtent() );
+    TSet< const UPrimitiveComponent * > gathered_primitive_components;
+    TArray< FOverlapResult > overlap_results;
+
+    for ( const auto collision_channel : generation_settings.GetCollisionChannels() )
+    {
+        overlap_results.Reset();
+
+        world.OverlapMultiByChannel(
+            overlap_results,
+            bounds.GetCenter(),
+            FQuat::Identity,
+            collision_channel,
+            collision_shape,
+            generation_settings.CollisionQueryParameters );
+
+        for ( const auto & overlap_result : overlap_results )
+        {
+            const auto * primitive_component = overlap_result.GetComponent();
+
+            if ( primitive_component == nullptr || !primitive_component->CanEverAffectNavigation() )
+            {
+                continue;
+            }
+
+            bool is_already_gathered;
+            gathered_primitive_components.Add( primitive_component, &is_already_gathered );
+
+            if ( !is_already_gathered )
+            {
+                primitive_components.Add( primitive_component );
+            }
+        }
+    }
+}
+
+void FSVOCollisionGeometrySnapshot::AddBodySetup( const UBodySetup & body_setup, const FTransform & component_transform )
+{
+    const auto & aggregate_geometry = body_setup.AggGeom;
+    const auto radius_scale = component_transform.GetScale3D().GetAbsMax();
+
+    TArray< FVector > vertices;
+
+    for ( const auto & box_element : aggregate_geometry.BoxElems )
+    {
+        const auto element_transform = box_element.GetTransform();
+        const FVector half_extent( box_element.X * 0.5f, box_element.Y * 0.5f, box_element.Z * 0.5f );
+
+        vertices.Reset( 8 );
+
+        for ( auto corner_index = 0; corner_index < 8; ++corner_index )
+        {
+            const FVector corner(
+                ( corner_index & 1 ) != 0 ? half_extent.X : -half_extent.X,
+                ( corner_index & 2 ) != 0 ? half_extent.Y : -half_extent.Y,
+                ( corner_index & 4 ) != 0 ? half_extent.Z : -half_extent.Z );
+
+            vertices.Add( component_transform.TransformPosition( element_transform.TransformPosition( corner ) ) );
+        }
+
+        AddConvex( vertices, BoxTriangleIndices );
+    }
+
+    for ( const auto & sphere_element : aggregate_geometry.SphereElems )
+    {
+        const auto center = component_transform.TransformPosition( sphere_element.Center );
+        AddSphere( center, center, sphere_element.Radius * radius_scale );
+    }
+
+    for ( const auto & capsule_element : aggregate_geometry.SphylElems )
+    {
+        const auto half_segment = capsule_element.Rotation.RotateVector( FVector::UpVector ) * capsule_element.Length * 0.5f;
+
+        AddSphere(
+            component_transform.TransformPosition( capsule_element.Center - half_segment ),
+            component_transform.TransformPosition( capsule_element.Center + half_segment ),
+            capsule_element.Radius * radius_scale );
+    }
+
+    for ( const auto & convex_element : aggregate_geometry.ConvexElems )
+    {
+        const auto element_transform = convex_element.GetTransform();
+
+        vertices.Reset( convex_element.VertexData.Num() );
+
+        for ( const auto & vertex : convex_element.VertexData )
+        {
+            vertices.Add( component_transform.TransformPosition( element_transform.TransformPosition( vertex ) ) );
+        }
+
+        if ( convex_element.IndexData.Num() > 0 )
+        {
+            AddConvex( vertices, convex_element.IndexData );
+        }
+        else
+        {
+            auto convex_element_with_indices = convex_element;
+            convex_element_with_indices.ComputeChaosConvexIndices();
+            AddConvex( vertices, convex_element_with_indices.IndexData );
+        }
+    }
+
+    if ( body_setup.GetCollisionTraceFlag() == CTF_UseComplexAsSimple )
+    {
+        if ( auto * collision_data_provider = Cast< IInterface_CollisionDataProvider >( body_setup.GetOuter() ) )
+        {
+            FTriMeshCollisionData triangle_mesh_data;
+            if ( collision_data_provider->GetPhysicsTriMeshData( &triangle_mesh_data, true ) )
+            {
+                vertices.Reset( triangle_mesh_data.Vertices.Num() );
+
+                for ( const auto & vertex : triangle_mesh_data.Vertices )
+                {
+                    vertices.Add( component_transform.TransformPosition( FVector( vertex ) ) );
+                }
+
+                TArray< int32 > indices;
+                indices.Reserve( triangle_mesh_data.Indices.Num() * 3 );
+
+                for ( const auto & triangle : triangle_mesh_data.Indices )
+                {
+                    indices.Append( { triangle.v0, triangle.v1, triangle.v2 } );
+                }
+
+                AddTriangleMesh( vertices, indices );
+            }
+        }
+    }
+}
+
+void FSVOCollisionGeometrySnapshot::AddSphere( const FVector & start, const FVector & end, const float radius )
+{
+    auto & shape = Shapes.AddDefaulted_GetRef();
+    shape.Type = start.Equals( end ) ? EShapeType::Sphere : EShapeType::Capsule;
+    shape.Bounds = FBox( start.ComponentMin( end ) - radius, start.ComponentMax( end ) + radius );
+    shape.Start = start;
+    shape.End = end;
+    shape.Radius = radius;
+    shape.FirstTriangle = 0;
+    shape.TriangleCount = 0;
+    shape.FirstPlane = 0;
+    shape.PlaneCount = 0;
+}
+
+void FSVOCollisionGeometrySnapshot::AddConvex( const TArray< FVector > & vertices, const TArray< int32 > & indices )
+{
+    if ( vertices.Num() == 0 || indices.Num() < 3 )
+    {
+        return;
+    }
+
+    auto & shape = Shapes.AddDefaulted_GetRef();
+    shape.Type = EShapeType::Convex;
+    shape.Bounds = FBox( vertices );
+    shape.Start = FVector::ZeroVector;
+    shape.End = FVector::ZeroVector;
+    shape.Radius = 0.0f;
+    shape.FirstTriangle = TriangleVertices.Num() / 3;
+    shape.TriangleCount = indices.Num() / 3;
+    shape.FirstPlane = Planes.Num();
+
+    FVector centroid( FVector::ZeroVector );
+    for ( const auto & vertex : vertices )
+    {
+        centroid += vertex;
+    }
+    centroid /= vertices.Num();
+
+    for ( auto index = 0; index + 2 < indices.Num(); index += 3 )
+    {
+        const auto & a = vertices[ indices[ index ] ];
+        const auto & b = vertices[ indices[ index + 1 ] ];
+        const auto & c = vertices[ indices[ index + 2 ] ];
+
+        TriangleVertices.Append( { a, b, c } );
+
+        auto normal = FVector::CrossProduct( b - a, c - a );
+        if ( normal.IsNearlyZero() )
+        {
+            continue;
+        }
+        normal.Normalize();
+
+        // The winding of the triangles is not reliable, so make all the planes point outside of the shape
+        FPlane plane( a, normal );
+        if ( plane.PlaneDot( centroid ) > 0.0f )
+        {
+            plane = plane.Flip();
+        }
+
+        Planes.Add( plane );
+    }
+
+    shape.PlaneCount = Planes.Num() - shape.FirstPlane;
+}
+
+void FSVOCollisionGeometrySnapshot::AddTriangleMesh( const TArray< FVector > & vertices, const TArray< int32 > & indices )
+{
+    // Each triangle is its own shape, so only the triangles near the tested boxes are tested
+    for ( auto index = 0; index + 2 < indices.Num(); index += 3 )
+    {
+        const auto & a = vertices[ indices[ index ] ];
+        const auto & b = vertices[ indices[ index + 1 ] ];
+        const auto & c = vertices[ indices[ index + 2 ] ];
+
+        auto & shape = Shapes.AddDefaulted_GetRef();
+        shape.Type = EShapeType::Triangle;
+        shape.Bounds = FBox( a.ComponentMin( b ).ComponentMin( c ), a.ComponentMax( b ).ComponentMax( c ) );
+        shape.Start = FVector::ZeroVector;
+        shape.End = FVector::ZeroVector;
+        shape.Radius = 0.0f;
+        shape.FirstTriangle = TriangleVertices.Num() / 3;
+        shape.TriangleCount = 1;
+        shape.FirstPlane = Planes.Num();
+        shape.PlaneCount = 0;
+
+        TriangleVertices.Append( { a, b, c } );
+    }
+}
+
+void FSVOCollisionGeometrySnapshot::BuildGrid()
+{
+    GridBounds.Init();
+    GridCellFirstShapeIndices.Reset();
+    GridCellShapeIndices.Reset();
+
+    for ( const auto & shape : Shapes )
+    {
+        GridBounds += shape.Bounds;
+    }
+
+    if ( !GridBounds.IsValid )
+    {
+        return;
+    }
+
+    const auto grid_bounds_size = GridBounds.GetSize();
+    GridCellSize = FMath::Max( grid_bounds_size.GetMax() / MaxGridCellsPerAxis, 1.0f );
+    GridSize = FIntVector(
+        FMath::Clamp( FMath::CeilToInt( grid_bounds_size.X / GridCellSize ), 1, MaxGridCellsPerAxis ),
+        FMath::Clamp( FMath::CeilToInt( grid_bounds_size.Y / GridCellSize ), 1, MaxGridCellsPerAxis ),
+        FMath::Clamp( FMath::CeilToInt( grid_bounds_size.Z / GridCellSize ), 1, MaxGridCellsPerAxis ) );
+
+    const auto get_cell_coords = [ this ]( const FVector & position ) {
+        const auto local_position = ( position - GridBounds.Min ) / GridCellSize;
+        return FIntVector(
+            FMath::Clamp( FMath::FloorToInt( local_position.X ), 0, GridSize.X - 1 ),
+            FMath::Clamp( FMath::FloorToInt( local_position.Y ), 0, GridSize.Y - 1 ),
+            FMath::Clamp( FMath::FloorToInt( local_position.Z ), 0, GridSize.Z - 1 ) );
+    };
+
+    const auto for_each_shape_cell = [ & ]( const FShape & shape, TFunctionRef< void( int32 ) > function ) {
+        const auto min_cell_coords = get_cell_coords( shape.Bounds.Min );
+        const auto max_cell_coords = get_cell_coords( shape.Bounds.Max );
+
+        for ( auto z = min_cell_coords.Z; z <= max_cell_coords.Z; ++z )
+        {
+            for ( auto y = min_cell_coords.Y; y <= max_cell_coords.Y; ++y )
+            {
+                for ( auto x = min_cell_coords.X; x <= max_cell_coords.X; ++x )
+                {
+                    function( x + GridSize.X * ( y + GridSize.Y * z ) );
+                }
+            }
+        }
+    };
+
+    // Counting sort of the shapes in the cells they overlap
+    const auto cell_count = GridSize.X * GridSize.Y * GridSize.Z;
+    GridCellFirstShapeIndices.SetNumZeroed( cell_count + 1 );
+
+    for ( const auto & shape : Shapes )
+    {
+        for_each_shape_cell( shape, [ & ]( const int32 cell_index ) {
+            GridCellFirstShapeIndices[ cell_index + 1 ]++;
+        } );
+    }
+
+    for ( auto cell_index = 0; cell_index < cell_count; ++cell_index )
+    {
+        GridCellFirstShapeIndices[ cell_index + 1 ] += GridCellFirstShapeIndices[ cell_index ];
+    }
+
+    TArray< int32 > cell_insertion_indices( GridCellFirstShapeIndices );
+    GridCellShapeIndices.SetNumUninitialized( GridCellFirstShapeIndices.Last() );
+
+    for ( auto shape_index = 0; shape_index < Shapes.Num(); ++shape_index )
+    {
+        for_each_shape_cell( Shapes[ shape_index ], [ & ]( const int32 cell_index ) {
+            GridCellShapeIndices[ cell_insertion_indices[ cell_index ]++ ] = shape_index;
+        } );
+    }
+}
+
+bool FSVOCollisionGeometrySnapshot::DoesShapeOverlapBox( const FShape & shape, const FVector & box_center, const FVector & box_extent ) const
+{
+    const FBox box( box_center - box_extent, box_center + box_extent );
+    const auto squared_radius = shape.Radius * shape.Radius;
+
+    switch ( shape.Type )
+    {
+        case EShapeType::Sphere:
+        {
+            return box.ComputeSquaredDistanceToPoint( shape.Start ) <= squared_radius;
+        }
+        case EShapeType::Capsule:
+        {
+            // The distance between the box and a point moving along the segment is a convex function, so a ternary search finds its minimum
+            float min_alpha = 0.0f;
+            float max_alpha = 1.0f;
+
+            for ( auto iteration = 0; iteration < CapsuleDistanceIterationCount; ++iteration )
+            {
+                const auto first_alpha = FMath::Lerp( min_alpha, max_alpha, 1.0f / 3.0f );
+                const auto second_alpha = FMath::Lerp( min_alpha, max_alpha, 2.0f / 3.0f );
+                const auto first_squared_distance = box.ComputeSquaredDistanceToPoint( FMath::Lerp( shape.Start, shape.End, first_alpha ) );
+                const auto second_squared_distance = box.ComputeSquaredDistanceToPoint( FMath::Lerp( shape.Start, shape.End, second_alpha ) );
+
+                if ( FMath::Min( first_squared_distance, second_squared_distance ) <= squared_radius )
+                {
+                    return true;
+                }
+
+                if ( first_squared_distance < second_squared_distance )
+                {
+                    max_alpha = second_alpha;
+                }
+                else
+                {
+                    min_alpha = first_alpha;
+                }
+            }
+
+            return box.ComputeSquaredDistanceToPoint( FMath::Lerp( shape.Start, shape.End, min_alpha ) ) <= squared_radius;
+        }
+        case EShapeType::Convex:
+        case EShapeType::Triangle:
+        {
+            // The faces of the convex are separating axes
+            for ( auto plane_index = shape.FirstPlane; plane_index < shape.FirstPlane + shape.PlaneCount; ++plane_index )
+            {
+                const auto & plane = Planes[ plane_index ];
+                const auto box_projected_extent = box_extent.X * FMath::Abs( plane.X ) + box_extent.Y * FMath::Abs( plane.Y ) + box_extent.Z * FMath::Abs( plane.Z );
+
+                if ( plane.PlaneDot( box_center ) > box_projected_extent )
+                {
+                    return false;
+                }
+            }
+
+            for ( auto triangle_index = shape.FirstTriangle; triangle_index < shape.FirstTriangle + shape.TriangleCount; ++triangle_index )
+            {
+                const auto vertex_index = triangle_index * 3;
+
+                if ( DoesTriangleOverlapBox( TriangleVertices[ vertex_index ], TriangleVertices[ vertex_index + 1 ], TriangleVertices[ vertex_index + 2 ], box_center, box_extent ) )
+                {
+                    return true;
+                }
+            }
+
+            // No face of the convex crosses the box, so either the box is completely inside the convex, or they don't overlap
+            if ( shape.PlaneCount == 0 )
+            {
+                return false;
+            }
+
+            for ( auto plane_index = shape.FirstPlane; plane_index < shape.FirstPlane + shape.PlaneCount; ++plane_index )
+            {
+                if ( Planes[ plane_index ].PlaneDot( box_center ) > 0.0f )
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+        default:
+        {
+            checkNoEntry();
+            return false;
+        }
+    }
+}
@@ -0,0 +1,114 @@
+#include "SVOGenerationCache.h"
+
+#include "SVONavigationSettings.h"
+#include "SVOVersion.h"
+#include "SVOVolumeNavigationData.h"
+
+#include <HAL/FileManager.h>
+#include <Misc/Paths.h>
+#include <Serialization/ObjectAndNameAsStringProxyArchive.h>
+
+namespace
+{
+    constexpr uint32 CacheFileMagic = 0x53564F43; // SVOC
+}
+
+FString FSVOGenerationCache::GetFilePath( const uint64 input_hash )
+{
+    const auto * settings = GetDefault< USVONavigationSettings >();
+
+    if ( !settings->bUseGenerationCache || input_hash == 0 )
+    {
+        return FString();
+    }
+
+    const auto directory = settings->GenerationCacheDirectory.Path.IsEmpty()
+                               ? FPaths::ProjectSavedDir() / TEXT( "SVONavigationCache" )
+                               : settings->GenerationCacheDirectory.Path;
+
+    return FPaths::ConvertRelativePathToFull( directory / FString::Printf( TEXT( "%016llx_%d.svo" ), input_hash, static_cast< int32 >( ESVOVersion::Latest ) ) );
+}
+
+bool FSVOGenerationCache::Load( FSVOVolumeNavigationData & data, const FString & file_path, const uint64 input_hash, const FBox & volume_bounds )
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOGenerationCache_Load );
+
+    const TUniquePtr< FArchive > reader( IFileManager::Get().CreateFileReader( *file_path, FILEREAD_Silent ) );
+
+    if ( !reader.IsValid() )
+    {
+        return false;
+    }
+
+    uint32 magic = 0;
+    auto version = static_cast< uint8 >( 0 );
+    uint64 file_input_hash = 0;
+
+    *reader << magic;
+    *reader << version;
+    *reader << file_input_hash;
+
+    if ( reader->IsError() || magic != CacheFileMagic || version != static_cast< uint8 >( ESVOVersion::Latest ) || file_input_hash != input_hash )
+    {
+        return false;
+    }
+
+    FSVOVolumeNavigationData loaded_data;
+
+    // The data references the class of its query filter
+    FObjectAndNameAsStringProxyArchive proxy_archive( *reader, true );
+    loaded_data.Serialize( proxy_archive, ESVOVersion::Latest );
+
+    if ( reader->IsError() || !loaded_data.GetData().IsValid() || loaded_data.GetVolumeBounds() != volume_bounds || loaded_data.GetInputHash() != input_hash )
+    {
+        UE_LOG( LogNavigation, Warning, TEXT( "Invalid SVO navigation generation cache file %s" ), *file_path );
+        return false;
+    }
+
+    data = MoveTemp( loaded_data );
+    return true;
+}
+
+bool FSVOGenerationCache::Save( FSVOVolumeNavigationData & data, const FString & file_path )
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOGenerationCache_Save );
+
+    auto & file_manager = IFileManager::Get();
+    const auto temporary_file_path = FString::Printf( TEXT( "%s.%s.tmp" ), *file_path, *FGuid::NewGuid().ToString() );
+
+    {
+        const TUniquePtr< FArchive > writer( file_manager.CreateFileWriter( *temporary_file_path, FILEWRITE_Silent ) );
+
+        if ( !writer.IsValid() )
+        {
+            UE_LOG( LogNavigation, Warning, TEXT( "Could not write the SVO navigation generation cache file %s" ), *temporary_file_path );
+            return false;
+        }
+
+        auto magic = CacheFileMagic;
+        auto version = static_cast< uint8 >( ESVOVersion::Latest );
+        auto input_hash = data.GetInputHash();
+
+        *writer << magic;
+        *writer << version;
+        *writer << input_hash;
+
+        FObjectAndNameAsStringProxyArchive proxy_archive( *writer, false );
+        data.Serialize( proxy_archive, ESVOVersion::Latest );
+
+        if ( !writer->Close() )
+        {
+            file_manager.Delete( *temporary_file_path, false, false, true );
+            return false;
+        }
+    }
+
+    // Another machine may have written the same file in the meantime. Its content is the same, so it can be replaced
+    if ( !file_manager.Move( *file_path, *temporary_file_path, true, true, false, true ) )
+    {
+        file_manager.Delete( *temporary_file_path, false, false, true );
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,71 @@
+#include "SVOGenerationCostModel.h"
+
+#include "SVOGenerationProgress.h"
+
+namespace
+{
+    // Each node of layer 1 contains 8 leaves, and each leaf contains 4x4x4 sub nodes
+    constexpr double LeafCountPerFirstPassNode = 8.0;
+    constexpr double SubNodeCountPerLeaf = 64.0;
+    // How much the last measure weighs in the time of an occlusion test
+    constexpr double SampleWeight = 0.25;
+
+    double GetLeafCount( const double generated_volume, const float leaf_size )
+    {
+        return generated_volume / ( static_cast< double >( leaf_size ) * leaf_size * leaf_size );
+    }
+
+    double GetOcclusionTestCount( const double leaf_count, const double occluded_leaf_count )
+    {
+        return leaf_count / LeafCountPerFirstPassNode + occluded_leaf_count * SubNodeCountPerLeaf;
+    }
+}
+
+FSVOGenerationCostModel::FSVOGenerationCostModel() :
+    AverageOccludedLeafRatio( 0.1f ),
+    SecondsPerOcclusionTest( 1.0e-6 ),
+    SampleCount( 0 )
+{
+}
+
+double FSVOGenerationCostModel::EstimateCost( const FBox & volume_bounds, const double generated_volume, const float leaf_size ) const
+{
+    const auto leaf_count = GetLeafCount( generated_volume, leaf_size );
+    const auto * occluded_leaf_ratio = VolumeOccludedLeafRatios.Find( volume_bounds );
+    const auto occluded_leaf_count = leaf_count * ( occluded_leaf_ratio != nullptr ? *occluded_leaf_ratio : AverageOccludedLeafRatio );
+
+    return GetOcclusionTestCount( leaf_count, occluded_leaf_count ) * SecondsPerOcclusionTest;
+}
+
+void FSVOGenerationCostModel::AddSample( const FBox & volume_bounds, const double generated_volume, const float leaf_size, const bool is_whole_volume, const FSVOVolumeGenerationProgressInfo & progress_info )
+{
+    const auto leaf_count = GetLeafCount( generated_volume, leaf_size );
+
+    // The elapsed time also counts the time the generation waited for the workers, which depends on the other generations
+    if ( leaf_count <= 0.0 || progress_info.TaskTime <= 0.0 )
+    {
+        return;
+    }
+
+    const auto seconds_per_occlusion_test = progress_info.TaskTime / GetOcclusionTestCount( leaf_count, progress_info.LeavesRasterized );
+
+    // The first measure replaces the default guess
+    SecondsPerOcclusionTest = SampleCount == 0
+                                  ? seconds_per_occlusion_test
+                                  : FMath::Lerp( SecondsPerOcclusionTest, seconds_per_occlusion_test, SampleWeight );
+    SampleCount++;
+
+    if ( !is_whole_volume )
+    {
+        return;
+    }
+
+    VolumeOccludedLeafRatios.Add( volume_bounds, FMath::Clamp( static_cast< float >( progress_info.LeavesRasterized / leaf_count ), 0.0f, 1.0f ) );
+
+    auto occluded_leaf_ratio_sum = 0.0f;
+    for ( const auto & pair : VolumeOccludedLeafRatios )
+    {
+        occluded_leaf_ratio_sum += pair.Value;
+    }
+    AverageOccludedLeafRatio = occluded_leaf_ratio_sum / VolumeOccludedLeafRatios.Num();
+}
@@ -0,0 +1,207 @@
+#include "SVOGenerationProgress.h"
+
+namespace
+{
+    constexpr int32 StageCount = static_cast< int32 >( ESVOGenerationStage::Count );
+
+    // Share of the whole generation each stage is supposed to take, to estimate the remaining time
+    constexpr float RasterizationCompletionRatio = 0.9f;
+    constexpr float LayerBuildCompletionRatio = 0.9f;
+    constexpr float ParentLinksCompletionRatio = 0.93f;
+    constexpr float NeighborLinksCompletionRatio = 0.95f;
+    constexpr float ClearanceFieldCompletionRatio = 0.97f;
+}
+
+const TCHAR * LexToString( const ESVOGenerationStage stage )
+{
+    switch ( stage )
+    {
+        case ESVOGenerationStage::Pending:
+            return TEXT( "Pending" );
+        case ESVOGenerationStage::FirstPass:
+            return TEXT( "First pass" );
+        case ESVOGenerationStage::LeafRasterization:
+            return TEXT( "Leaf rasterization" );
+        case ESVOGenerationStage::LayerBuild:
+            return TEXT( "Layer build" );
+        case ESVOGenerationStage::ParentLinks:
+            return TEXT( "Parent links" );
+        case ESVOGenerationStage::NeighborLinks:
+            return TEXT( "Neighbor links" );
+        case ESVOGenerationStage::ClearanceField:
+            return TEXT( "Clearance field" );
+        case ESVOGenerationStage::Finished:
+            return TEXT( "Finished" );
+        default:
+            return TEXT( "Unknown" );
+    }
+}
+
+FSVOVolumeGenerationProgressInfo::FSVOVolumeGenerationProgressInfo() :
+    VolumeBounds( ForceInit ),
+    Stage( ESVOGenerationStage::Pending ),
+    TilesDone( 0 ),
+    TileCount( 0 ),
+    LeavesRasterized( 0 ),
+    LeavesExpected( 0 ),
+    ElapsedTime( 0.0 ),
+    TaskTime( 0.0 ),
+    EstimatedRemainingTime( -1.0 ),
+    PeakMemory( 0 ),
+    RetainedMemory( 0 )
+{
+    FMemory::Memzero( StageTimes );
+}
+
+float FSVOVolumeGenerationProgressInfo::GetCompletionRatio() const
+{
+    switch ( Stage )
+    {
+        case ESVOGenerationStage::Pending:
+            return 0.0f;
+        case ESVOGenerationStage::FirstPass:
+        case ESVOGenerationStage::LeafRasterization:
+        {
+            // Incremental updates have no tiles, only leaves
+            if ( TileCount > 0 )
+            {
+                return RasterizationCompletionRatio * TilesDone / TileCount;
+            }
+            return LeavesExpected > 0 ? RasterizationCompletionRatio * LeavesRasterized / LeavesExpected : 0.0f;
+        }
+        case ESVOGenerationStage::LayerBuild:
+            return LayerBuildCompletionRatio;
+        case ESVOGenerationStage::ParentLinks:
+            return ParentLinksCompletionRatio;
+        case ESVOGenerationStage::NeighborLinks:
+            return NeighborLinksCompletionRatio;
+        case ESVOGenerationStage::ClearanceField:
+            return ClearanceFieldCompletionRatio;
+        default:
+            return 1.0f;
+    }
+}
+
+FSVOGenerationProgress::FSVOGenerationProgress() :
+    Stage( static_cast< uint8 >( ESVOGenerationStage::Pending ) ),
+    TilesDone( 0 ),
+    TileCount( 0 ),
+    LeavesRasterized( 0 ),
+    LeavesExpected( 0 ),
+    FinishCycles( 0 ),
+    TaskCycles( 0 ),
+    PeakMemory( 0 ),
+    RetainedMemory( 0 ),
+    StartCycles( FPlatformTime::Cycles64() )
+{
+    for ( auto stage_index = 0; stage_index < StageCount; ++stage_index )
+    {
+        StageStartCycles[ stage_index ] = 0;
+        StageEndCycles[ stage_index ] = 0;
+    }
+}
+
+void FSVOGenerationProgress::SetTileCount( const int32 tile_count )
+{
+    TileCount = tile_count;
+}
+
+void FSVOGenerationProgress::OnTileDone()
+{
+    ++TilesDone;
+}
+
+void FSVOGenerationProgress::AddExpectedLeaves( const int32 leaf_count )
+{
+    LeavesExpected += leaf_count;
+}
+
+void FSVOGenerationProgress::AddRasterizedLeaves( const int32 leaf_count )
+{
+    LeavesRasterized += leaf_count;
+}
+
+void FSVOGenerationProgress::BeginStage( const ESVOGenerationStage stage )
+{
+    const auto stage_index = static_cast< uint8 >( stage );
+    const auto now = FPlatformTime::Cycles64();
+
+    // The stages run by the tiles start several times, keep the earliest start
+    auto start_cycles = StageStartCycles[ stage_index ].load();
+    while ( ( start_cycles == 0 || now < start_cycles ) && !StageStartCycles[ stage_index ].compare_exchange_weak( start_cycles, now ) )
+    {
+    }
+
+    auto current_stage = Stage.load();
+    while ( current_stage < stage_index && !Stage.compare_exchange_weak( current_stage, stage_index ) )
+    {
+    }
+}
+
+void FSVOGenerationProgress::EndStage( const ESVOGenerationStage stage )
+{
+    const auto stage_index = static_cast< uint8 >( stage );
+    const auto now = FPlatformTime::Cycles64();
+
+    // Keep the latest end
+    auto end_cycles = StageEndCycles[ stage_index ].load();
+    while ( end_cycles < now && !StageEndCycles[ stage_index ].compare_exchange_weak( end_cycles, now ) )
+    {
+    }
+}
+
+void FSVOGenerationProgress::AddTaskCycles( const uint64 cycles )
+{
+    TaskCycles += cycles;
+}
+
+void FSVOGenerationProgress::SetMemoryUsage( const int64 peak_memory, const int64 retained_memory )
+{
+    PeakMemory = peak_memory;
+    RetainedMemory = retained_memory;
+}
+
+void FSVOGenerationProgress::Finish()
+{
+    FinishCycles = FPlatformTime::Cycles64();
+    Stage = static_cast< uint8 >( ESVOGenerationStage::Finished );
+}
+
+FSVOVolumeGenerationProgressInfo FSVOGenerationProgress::GetInfo() const
+{
+    const auto finish_cycles = FinishCycles.load();
+    const auto now = finish_cycles != 0 ? finish_cycles : FPlatformTime::Cycles64();
+
+    FSVOVolumeGenerationProgressInfo info;
+    info.Stage = static_cast< ESVOGenerationStage >( Stage.load() );
+    info.TilesDone = TilesDone;
+    info.TileCount = TileCount;
+    info.LeavesRasterized = LeavesRasterized;
+    info.LeavesExpected = LeavesExpected;
+    info.ElapsedTime = FPlatformTime::ToSeconds64( now - StartCycles );
+    info.TaskTime = FPlatformTime::ToSeconds64( TaskCycles.load() );
+    info.PeakMemory = PeakMemory;
+    info.RetainedMemory = RetainedMemory;
+
+    for ( auto stage_index = 0; stage_index < StageCount; ++stage_index )
+    {
+        const auto start_cycles = StageStartCycles[ stage_index ].load();
+
+        if ( start_cycles == 0 )
+        {
+            continue;
+        }
+
+        // The stage is still running if it did not end after its latest start
+        const auto end_cycles = FMath::Max( StageEndCycles[ stage_index ].load(), start_cycles );
+        info.StageTimes[ stage_index ] = FPlatformTime::ToSeconds64( ( info.Stage == static_cast< ESVOGenerationStage >( stage_index ) ? now : end_cycles ) - start_cycles );
+    }
+
+    const auto completion_ratio = info.GetCompletionRatio();
+    if ( completion_ratio > 0.0f )
+    {
+        info.EstimatedRemainingTime = info.ElapsedTime * ( 1.0f - completion_ratio ) / completion_ratio;
+    }
+
+    return info;
+}
@@ -1,5 +1,22 @@
 #include "SVONavigation.h"
 
+#include "SVONavigationStats.h"
+
+DEFINE_STAT( STAT_SVONavigation_PendingGenerationCount );
+DEFINE_STAT( STAT_SVONavigation_RunningGenerationCount );
+DEFINE_STAT( STAT_SVONavigation_RunningTileTaskCount );
+DEFINE_STAT( STAT_SVONavigation_WaitingResultCount );
+DEFINE_STAT( STAT_SVONavigation_DebouncedDirtyAreaCount );
+DEFINE_STAT( STAT_SVONavigation_ApplyLatency );
+DEFINE_STAT( STAT_SVONavigation_LeavesRasterized );
+DEFINE_STAT( STAT_SVONavigation_LeavesExpected );
+DEFINE_STAT( STAT_SVONavigation_EstimatedRemainingTime );
+DEFINE_STAT( STAT_SVONavigation_LastGenerationPeakMemory );
+DEFINE_STAT( STAT_SVONavigation_LastGenerationRetainedMemory );
+DEFINE_STAT( STAT_SVONavigation_ApplyResults );
+DEFINE_STAT( STAT_SVONavigation_ResolveLeaf );
+DEFINE_STAT( STAT_SVONavigation_ResolvedLeafCount );
+
 #define LOCTEXT_NAMESPACE "FSVONavigationModule"
 
 void FSVONavigationModule::StartupModule()
@@ -40,6 +40,9 @@ ASVONavigationData::ASVONavigationData() :
     Version( ESVOVersion::Latest )
 {
     MaxSimultaneousBoxGenerationJobsCount = 1024;
+    MaxResultsApplyTimePerFrame = 2.0f;
+    InvokerCellSize = 5000.0f;
+    DirtyAreasDebounceTime = 0.2f;
 
     if ( !HasAnyFlags( RF_ClassDefaultObject ) )
     {
@@ -186,8 +189,8 @@ void ASVONavigationData::EnsureBuildCompletion()
 
 bool ASVONavigationData::SupportsRuntimeGeneration() const
 {
-    // :TODO:
-    return false;
+    // There are no navigation modifiers, so DynamicModifiersOnly behaves like Static
+    return RuntimeGeneration == ERuntimeGenerationType::Dynamic;
 }
 
 bool ASVONavigationData::SupportsStreaming() const
@@ -573,13 +576,23 @@ void ASVONavigationData::AddVolumeNavigationData( FSVOVolumeNavigationData data
         }
     }
 
+    // Replace the existing data in a single step, so the old data can be queried until the new one is ready
+    if ( auto * existing_data = VolumeNavigationData.FindByPredicate( [ &data ]( const FSVOVolumeNavigationData & volume_navigation_data ) {
+             return volume_navigation_data.GetVolumeBounds() == data.GetVolumeBounds();
+         } ) )
+    {
+        *existing_data = MoveTemp( data );
+        return;
+    }
+
     VolumeNavigationData.Emplace( MoveTemp( data ) );
 }
 
 const FSVOVolumeNavigationData * ASVONavigationData::GetVolumeNavigationDataContainingPoints( const TArray< FVector > & points ) const
 {
     return VolumeNavigationData.FindByPredicate( [ this, &points ]( const FSVOVolumeNavigationData & data ) {
-        const auto & bounds = data.GetData().GetNavigationBounds();
+        // The space of the navigation bounds outside of the volume bounds is not rasterized
+        const auto & bounds = data.GetVolumeBounds();
         for ( const auto & point : points )
         {
             if ( !bounds.IsInside( point ) )
@@ -591,6 +604,15 @@ const FSVOVolumeNavigationData * ASVONavigationData::GetVolumeNavigationDataCont
     } );
 }
 
+void ASVONavigationData::GetGenerationProgress( TArray< FSVOVolumeGenerationProgressInfo > & progress_infos ) const
+{
+    // The generator is always a FSVONavigationDataGenerator, see ConditionalConstructGenerator
+    if ( const auto * generator = static_cast< const FSVONavigationDataGenerator * >( NavDataGenerator.Get() ) )
+    {
+        generator->GetGenerationProgress( progress_infos );
+    }
+}
+
 void ASVONavigationData::UpdateNavVersion()
 {
     Version = ESVOVersion::Latest;
@@ -1,33 +1,206 @@
 #include "SVONavigationDataGenerator.h"
 
+#include "SVOCollisionGeometrySnapshot.h"
+#include "SVOGenerationCache.h"
 #include "SVONavigationData.h"
+#include "SVONavigationStats.h"
+#include "SVOResolutionModifierVolume.h"
 
+#include <EngineUtils.h>
 #include <GameFramework/PlayerController.h>
+#include <HAL/FileManager.h>
+#include <Hash/CityHash.h>
 #include <NavigationSystem.h>
 
-FSVOVolumeNavigationDataGenerator::FSVOVolumeNavigationDataGenerator( FSVONavigationDataGenerator & navigation_data_generator, const FBox & volume_bounds ) :
+namespace
+{
+    // The dirty areas which keep changing are rebuilt after waiting that many times the debounce time
+    constexpr double MaxDebounceTimeFactor = 10.0;
+    // Added to the distance of the volumes to the seed locations, so the cost of the volumes which contain a seed location still counts
+    constexpr double SeedDistanceBias = 1000.0;
+}
+
+FSVOVolumeNavigationDataGenerator::FSVOVolumeNavigationDataGenerator( FSVONavigationDataGenerator & navigation_data_generator, const FBox & volume_bounds, const TArray< FBox > & dirty_bounds ) :
     ParentGenerator( navigation_data_generator ),
     BoundsNavigationData(),
-    VolumeBounds( volume_bounds )
+    VolumeBounds( volume_bounds ),
+    Progress( MakeShared< FSVOGenerationProgress, ESPMode::ThreadSafe >() ),
+    bIsUpToDate( false ),
+    bShouldLoadFromCache( false ),
+    bIsLoadedFromCache( false )
 {
     NavDataConfig = navigation_data_generator.GetOwner()->GetConfig();
+
+    DataGenerationSettings.GenerationSettings = ParentGenerator.GetGenerationSettings();
+    DataGenerationSettings.World = ParentGenerator.GetWorld();
+    DataGenerationSettings.VoxelExtent = NavDataConfig.AgentRadius * 2.0f;
+    DataGenerationSettings.CancellationToken = CancellationToken = MakeShared< std::atomic< bool >, ESPMode::ThreadSafe >( false );
+    DataGenerationSettings.Progress = Progress;
+    DataGenerationSettings.InvokerCells = ParentGenerator.GetInvokerCells( volume_bounds );
+
+    const auto & generation_settings = DataGenerationSettings.GenerationSettings;
+
+    // The occlusion of bigger agents is derived from the data generated for the smallest agent instead of being rasterized again
+    const FSVOVolumeNavigationData * finest_data = nullptr;
+
+    if ( const auto * finest_navigation_data = ParentGenerator.GetFinestNavigationData() )
+    {
+        finest_data = finest_navigation_data->GetVolumeNavigationData().FindByPredicate( [ &volume_bounds ]( const FSVOVolumeNavigationData & data ) {
+            return data.GetVolumeBounds() == volume_bounds && data.GetData().IsValid();
+        } );
+    }
+
+    const auto * existing_data = navigation_data_generator.GetOwner()->GetVolumeNavigationData().FindByPredicate( [ &volume_bounds ]( const FSVOVolumeNavigationData & data ) {
+        return data.GetVolumeBounds() == volume_bounds && data.GetData().IsValid();
+    } );
+
+    // Only the dirty bounds are rasterized again in the existing data
+    const auto is_incremental_update = dirty_bounds.Num() > 0 && existing_data != nullptr;
+
+    if ( DataGenerationSettings.World.IsValid() )
+    {
+        const auto navigation_bounds = FSVOData::ComputeNavigationBounds( DataGenerationSettings.VoxelExtent, volume_bounds );
+
+        for ( TActorIterator< ASVOResolutionModifierVolume > iterator( DataGenerationSettings.World.Get() ); iterator; ++iterator )
+        {
+            const auto modifier_bounds = iterator->GetComponentsBoundingBox( true );
+
+            if ( modifier_bounds.Intersect( navigation_bounds ) )
+            {
+                DataGenerationSettings.ResolutionModifiers.Add( { modifier_bounds, iterator->GetResolution() } );
+            }
+        }
+
+        // The hash gathers all the primitives around the volume, which would cost more than the incremental update itself on the game thread.
+        // The updated data then has no hash, so it is neither skipped as up to date nor written to the generation cache until its next full generation
+        if ( !is_incremental_update )
+        {
+            DataGenerationSettings.InputHash = FSVOVolumeNavigationData::ComputeInputHash( *DataGenerationSettings.World, volume_bounds, DataGenerationSettings );
+        }
+
+        // The generated data also depends on the data it is derived from
+        if ( finest_data != nullptr && DataGenerationSettings.InputHash != 0 )
+        {
+            DataGenerationSettings.InputHash = finest_data->GetInputHash() != 0
+                                                   ? CityHash128to64( Uint128_64( DataGenerationSettings.InputHash, finest_data->GetInputHash() ) )
+                                                   : 0;
+        }
+    }
+
+    // Generating again would give the same data
+    if ( existing_data != nullptr && DataGenerationSettings.InputHash != 0 && existing_data->GetInputHash() == DataGenerationSettings.InputHash )
+    {
+        bIsUpToDate = true;
+        return;
+    }
+
+    // The whole volume can be replaced by cached data generated from the same inputs. Empty for the incremental updates, which have no hash
+    // The file is read by the background task, which still generates the data if the file can't be loaded
+    CacheFilePath = FSVOGenerationCache::GetFilePath( DataGenerationSettings.InputHash );
+    bShouldLoadFromCache = !CacheFilePath.IsEmpty() && IFileManager::Get().FileExists( *CacheFilePath );
+
+    FBox gather_bounds = FSVOData::ComputeNavigationBounds( DataGenerationSettings.VoxelExtent, volume_bounds ).ExpandBy( generation_settings.Clearance );
+
+    if ( is_incremental_update )
+    {
+        // Only shares the octree of the existing data. The task which updates it makes its own copy
+        BoundsNavigationData = *existing_data;
+        DirtyBounds = dirty_bounds;
+
+        // Whole nodes of layer 1 are rasterized again around the dirty bounds
+        const auto gather_extent = BoundsNavigationData.GetData().GetLayer( 1 ).GetNodeSize() + generation_settings.Clearance;
+
+        gather_bounds.Init();
+        for ( const auto & dirty_box : dirty_bounds )
+        {
+            gather_bounds += dirty_box.ExpandBy( gather_extent );
+        }
+    }
+
+    // The generator is created on the game thread, so this is where the geometry can be captured before the generation runs on the worker threads
+    if ( generation_settings.OcclusionSource == ESVOOcclusionSource::CollisionGeometrySnapshot && DataGenerationSettings.World.IsValid() )
+    {
+        const auto snapshot = MakeShared< FSVOCollisionGeometrySnapshot, ESPMode::ThreadSafe >();
+        snapshot->Gather( *DataGenerationSettings.World, gather_bounds, generation_settings );
+        DataGenerationSettings.CollisionGeometrySnapshot = snapshot;
+    }
+
+    // Shares the octree of the finest navigation data, which stays alive if the finest data is generated again while this data is generated
+    if ( finest_data != nullptr )
+    {
+        DataGenerationSettings.FinestNavigationData = MakeShared< FSVOVolumeNavigationData, ESPMode::ThreadSafe >( *finest_data );
+    }
+
+    // No tile is rasterized when the data is expected to be loaded from the cache
+    if ( DirtyBounds.Num() == 0 && !bShouldLoadFromCache && BoundsNavigationData.BeginGeneration( VolumeBounds, DataGenerationSettings ) )
+    {
+        Tiles.SetNum( BoundsNavigationData.GetTileCount() );
+    }
+}
+
+void FSVOVolumeNavigationDataGenerator::RasterizeTile( const int32 tile_index )
+{
+    BoundsNavigationData.RasterizeTile( Tiles[ tile_index ], tile_index );
 }
 
 bool FSVOVolumeNavigationDataGenerator::DoWork()
 {
-    FSVOVolumeNavigationDataGenerationSettings generation_settings;
-    generation_settings.GenerationSettings = ParentGenerator.GetGenerationSettings();
-    generation_settings.World = ParentGenerator.GetWorld();
-    generation_settings.VoxelExtent = NavDataConfig.AgentRadius * 2.0f;
+    if ( bShouldLoadFromCache )
+    {
+        FSVOVolumeNavigationData cached_data;
+
+        if ( FSVOGenerationCache::Load( cached_data, CacheFilePath, DataGenerationSettings.InputHash, VolumeBounds ) )
+        {
+            BoundsNavigationData = MoveTemp( cached_data );
+            bIsLoadedFromCache = true;
+
+            DataGenerationSettings.CollisionGeometrySnapshot.Reset();
+            DataGenerationSettings.FinestNavigationData.Reset();
+            return true;
+        }
+
+        // The tiles were not created for the invalid file, so the whole volume is rasterized by this task
+        if ( DirtyBounds.Num() == 0 && BoundsNavigationData.BeginGeneration( VolumeBounds, DataGenerationSettings ) )
+        {
+            Tiles.SetNum( BoundsNavigationData.GetTileCount() );
+
+            for ( int32 tile_index = 0; tile_index < Tiles.Num() && !CancellationToken->load(); ++tile_index )
+            {
+                RasterizeTile( tile_index );
+            }
+        }
+    }
+
+    if ( DirtyBounds.Num() > 0 )
+    {
+        BoundsNavigationData.UpdateNavigationData( DirtyBounds, DataGenerationSettings );
+    }
+    else
+    {
+        BoundsNavigationData.FinishGeneration( Tiles );
+        Tiles.Empty();
+    }
 
-    BoundsNavigationData.GenerateNavigationData( VolumeBounds, generation_settings );
+    DataGenerationSettings.CollisionGeometrySnapshot.Reset();
+    DataGenerationSettings.FinestNavigationData.Reset();
+
+    if ( !CacheFilePath.IsEmpty() && BoundsNavigationData.GetData().IsValid() && !CancellationToken->load() )
+    {
+        FSVOGenerationCache::Save( BoundsNavigationData, CacheFilePath );
+    }
 
     return true;
 }
 
+void FSVOVolumeNavigationDataGenerator::Cancel()
+{
+    CancellationToken->store( true );
+}
+
 FSVONavigationDataGenerator::FSVONavigationDataGenerator( ASVONavigationData & navigation_data ) :
     NavigationData( navigation_data ),
     MaximumGeneratorTaskCount( 2 ),
+    MaximumTileTaskCount( 2 ),
     IsInitialized( false )
 {
 }
@@ -43,6 +216,10 @@ void FSVONavigationDataGenerator::Init()
     MaximumGeneratorTaskCount = FMath::Min( FMath::Max( worker_threads_count * 2, 1 ), NavigationData.MaxSimultaneousBoxGenerationJobsCount );
     UE_LOG( LogNavigation, Log, TEXT( "Using max of %d workers to build SVO navigation." ), MaximumGeneratorTaskCount );
 
+    // The tile tasks run in the global thread pool
+    const int32 pool_threads_count = GThreadPool != nullptr ? GThreadPool->GetNumThreads() : worker_threads_count;
+    MaximumTileTaskCount = FMath::Max( pool_threads_count * 2, 1 );
+
     // IsInitialized = true;
 
     //// recreate navmesh if no data was loaded, or when loaded data doesn't match current grid layout
@@ -80,7 +257,7 @@ bool FSVONavigationDataGenerator::RebuildAll()
         dirty_areas.Emplace( FNavigationDirtyArea( registered_navigation_bounds, 0 ) );
     }
 
-    RebuildDirtyAreas( dirty_areas );
+    QueueDirtyAreas( dirty_areas );
 
     NavigationData.RequestDrawingUpdate();
     return true;
@@ -88,20 +265,43 @@ bool FSVONavigationDataGenerator::RebuildAll()
 
 void FSVONavigationDataGenerator::EnsureBuildCompletion()
 {
+    // The volumes waiting for the finest navigation data would never be generated otherwise
+    if ( auto * finest_navigation_data = GetFinestNavigationData() )
+    {
+        finest_navigation_data->EnsureBuildCompletion();
+    }
+
     const bool had_tasks = GetNumRemaningBuildTasks() > 0;
 
+    SubmitDebouncedDirtyAreas( true );
+
+    TArray< FBox > finished_boxes;
+
     do
     {
         const int32 tasks_to_process_count = MaximumGeneratorTaskCount - RunningBoundsDataGenerationElements.Num();
-        ProcessAsyncTasks( tasks_to_process_count );
+        finished_boxes.Append( ProcessAsyncTasks( tasks_to_process_count ) );
 
-        // Block until tasks are finished
+        // Block until tasks are finished. The stitching tasks are started by the next call to ProcessAsyncTasks once all the tiles are done
         for ( auto & element : RunningBoundsDataGenerationElements )
         {
-            element.AsyncTask->EnsureCompletion();
+            for ( auto * tile_task : element.TileTasks )
+            {
+                tile_task->EnsureCompletion();
+            }
+
+            if ( element.AsyncTask != nullptr )
+            {
+                element.AsyncTask->EnsureCompletion();
+            }
         }
     } while ( GetNumRemaningBuildTasks() > 0 );
 
+    if ( finished_boxes.Num() > 0 )
+    {
+        NavigationData.OnNavigationDataUpdatedInBounds( finished_boxes );
+    }
+
     if ( had_tasks )
     {
         NavigationData.RequestDrawingUpdate();
@@ -111,15 +311,17 @@ void FSVONavigationDataGenerator::EnsureBuildCompletion()
 void FSVONavigationDataGenerator::CancelBuild()
 {
     PendingBoundsDataGenerationElements.Empty();
+    DebouncedDirtyAreas.Empty();
 
+    // Cancel all the generators first, so the tasks which already started stop as soon as possible
     for ( auto & element : RunningBoundsDataGenerationElements )
     {
-        if ( element.AsyncTask )
-        {
-            element.AsyncTask->EnsureCompletion();
-            delete element.AsyncTask;
-            element.AsyncTask = nullptr;
-        }
+        element.BoxNavigationDataGenerator->Cancel();
+    }
+
+    for ( auto & element : RunningBoundsDataGenerationElements )
+    {
+        element.DeleteTasks();
     }
 
     RunningBoundsDataGenerationElements.Empty();
@@ -137,7 +339,14 @@ void FSVONavigationDataGenerator::TickAsyncBuild( float delta_seconds )
 
     const int32 tasks_to_submit_count = MaximumGeneratorTaskCount - running_tasks_count;
 
-    const auto finished_boxes = ProcessAsyncTasks( tasks_to_submit_count );
+    if ( IsGeneratingAroundInvokersOnly() )
+    {
+        UpdateInvokerCells();
+    }
+
+    SubmitDebouncedDirtyAreas( false );
+
+    const auto finished_boxes = ProcessAsyncTasks( tasks_to_submit_count, NavigationData.MaxResultsApplyTimePerFrame / 1000.0 );
 
     if ( finished_boxes.Num() > 0 )
     {
@@ -152,6 +361,72 @@ void FSVONavigationDataGenerator::OnNavigationBoundsChanged()
 }
 
 void FSVONavigationDataGenerator::RebuildDirtyAreas( const TArray< FNavigationDirtyArea > & dirty_areas )
+{
+    if ( NavigationData.DirtyAreasDebounceTime <= 0.0f )
+    {
+        QueueDirtyAreas( dirty_areas );
+        return;
+    }
+
+    const auto now = FPlatformTime::Seconds();
+
+    for ( const auto & dirty_area : dirty_areas )
+    {
+        FSVODebouncedDirtyArea debounced_dirty_area { dirty_area.Bounds, dirty_area.Flags, now, now };
+
+        // Merge the accumulated areas the new area overlaps. The union can overlap areas which were already tested, so start again after each merge
+        for ( auto area_index = 0; area_index < DebouncedDirtyAreas.Num(); )
+        {
+            const auto & other_area = DebouncedDirtyAreas[ area_index ];
+
+            if ( !other_area.Bounds.Intersect( debounced_dirty_area.Bounds ) )
+            {
+                ++area_index;
+                continue;
+            }
+
+            debounced_dirty_area.Bounds += other_area.Bounds;
+            debounced_dirty_area.Flags |= other_area.Flags;
+            debounced_dirty_area.FirstDirtyTime = FMath::Min( debounced_dirty_area.FirstDirtyTime, other_area.FirstDirtyTime );
+
+            DebouncedDirtyAreas.RemoveAtSwap( area_index );
+            area_index = 0;
+        }
+
+        DebouncedDirtyAreas.Add( debounced_dirty_area );
+    }
+}
+
+void FSVONavigationDataGenerator::SubmitDebouncedDirtyAreas( const bool submit_all )
+{
+    if ( DebouncedDirtyAreas.Num() == 0 )
+    {
+        return;
+    }
+
+    const auto now = FPlatformTime::Seconds();
+    const auto debounce_time = NavigationData.DirtyAreasDebounceTime;
+    TArray< FNavigationDirtyArea > dirty_areas;
+
+    for ( auto area_index = DebouncedDirtyAreas.Num() - 1; area_index >= 0; --area_index )
+    {
+        const auto & debounced_dirty_area = DebouncedDirtyAreas[ area_index ];
+
+        // The areas which never stop changing are still rebuilt from time to time
+        if ( submit_all || now - debounced_dirty_area.LastDirtyTime >= debounce_time || now - debounced_dirty_area.FirstDirtyTime >= debounce_time * MaxDebounceTimeFactor )
+        {
+            dirty_areas.Emplace( FNavigationDirtyArea( debounced_dirty_area.Bounds, debounced_dirty_area.Flags ) );
+            DebouncedDirtyAreas.RemoveAtSwap( area_index );
+        }
+    }
+
+    if ( dirty_areas.Num() > 0 )
+    {
+        QueueDirtyAreas( dirty_areas );
+    }
+}
+
+void FSVONavigationDataGenerator::QueueDirtyAreas( const TArray< FNavigationDirtyArea > & dirty_areas )
 {
     // The dirty areas are not always in the navigation bounds. If we move a static mesh outside of the navigation bounds, that function is called nonetheless
     // So let's first keep only the areas which are in the known navigation bounds
@@ -163,35 +438,98 @@ void FSVONavigationDataGenerator::RebuildDirtyAreas( const TArray< FNavigationDi
 
         for ( const auto & matching_bounds_element : matching_bounds )
         {
-            // Don't add another pending generation if one is already there for the navigation bounds the dirty area is in
-            if ( PendingBoundsDataGenerationElements.FindByPredicate( [ &matching_bounds_element ]( const FPendingBoundsDataGenerationElement & pending_element ) {
-                     return pending_element.VolumeBounds == matching_bounds_element;
-                 } ) == nullptr )
+            const auto can_update_incrementally = CanUpdateVolumeIncrementally( matching_bounds_element, dirty_area.Bounds );
+
+            // Don't add another pending generation if one is already there for the navigation bounds the dirty area is in.
+            // A pending element only starts once the running generation of its volume is finished, so it also updates what changed while that generation was running
+            auto * pending_element = PendingBoundsDataGenerationElements.Find( matching_bounds_element );
+
+            if ( pending_element == nullptr )
             {
                 FPendingBoundsDataGenerationElement pending_box_element;
                 pending_box_element.VolumeBounds = matching_bounds_element;
-                PendingBoundsDataGenerationElements.Emplace( pending_box_element );
+                pending_box_element.QueueTime = FPlatformTime::Seconds();
 
-                NavigationData.RemoveDataInBounds( matching_bounds_element );
+                if ( can_update_incrementally )
+                {
+                    pending_box_element.DirtyBounds.Add( dirty_area.Bounds );
+                }
+
+                pending_element = &PendingBoundsDataGenerationElements.Add( matching_bounds_element, pending_box_element );
+            }
+            else if ( pending_element->DirtyBounds.Num() > 0 )
+            {
+                // The pending element only updates parts of the volume
+                // The invoker cells which an invoker leaves and enters again while the element is pending are only updated once
+                if ( can_update_incrementally )
+                {
+                    pending_element->DirtyBounds.AddUnique( dirty_area.Bounds );
+                }
+                else
+                {
+                    pending_element->DirtyBounds.Reset();
+                }
+            }
+
+            // The results of a running incremental update are useless when the whole volume is generated again after it. The other running generations are kept,
+            // so the volumes whose areas keep changing are still generated, instead of restarting their generation each time
+            if ( pending_element->DirtyBounds.Num() == 0 )
+            {
+                if ( auto * running_element = RunningBoundsDataGenerationElements.FindByPredicate( [ &matching_bounds_element ]( const FRunningBoundsDataGenerationElement & element ) {
+                         return element.VolumeBounds == matching_bounds_element && !element.ShouldDiscard && element.DirtyBounds.Num() > 0;
+                     } ) )
+                {
+                    running_element->ShouldDiscard = true;
+                    running_element->BoxNavigationDataGenerator->Cancel();
+                }
             }
         }
     }
+}
+
+bool FSVONavigationDataGenerator::CanUpdateVolumeIncrementally( const FBox & volume_bounds, const FBox & dirty_bounds ) const
+{
+    if ( !GenerationSettings.bRebuildDirtyAreasIncrementally || dirty_bounds.IsInsideOrOn( volume_bounds ) )
+    {
+        return false;
+    }
 
-    // Sort tiles by proximity to players
-    if ( PendingBoundsDataGenerationElements.Num() > 0 )
+    // The pending element only starts once the running generation of the volume is finished, so it updates the data of that generation.
+    // This way the invoker cells which change during the first generation of a volume around the invokers don't generate the whole volume again
+    if ( RunningBoundsDataGenerationElements.ContainsByPredicate( [ &volume_bounds ]( const FRunningBoundsDataGenerationElement & element ) {
+             return element.VolumeBounds == volume_bounds && !element.ShouldDiscard;
+         } ) )
     {
-        SortPendingBounds();
+        return true;
     }
+
+    return NavigationData.GetVolumeNavigationData().FindByPredicate( [ &volume_bounds ]( const FSVOVolumeNavigationData & data ) {
+        return data.GetVolumeBounds() == volume_bounds && data.GetData().IsValid();
+    } ) != nullptr;
+}
+
+bool FSVONavigationDataGenerator::IsWaitingForFinestNavigationData( const FBox & volume_bounds ) const
+{
+    const auto * finest_navigation_data = GetFinestNavigationData();
+
+    if ( finest_navigation_data == nullptr )
+    {
+        return false;
+    }
+
+    // The generator is always a FSVONavigationDataGenerator, see ASVONavigationData::ConditionalConstructGenerator
+    const auto * finest_generator = static_cast< const FSVONavigationDataGenerator * >( finest_navigation_data->GetGenerator() );
+    return finest_generator != nullptr && finest_generator->IsGeneratingVolume( volume_bounds );
 }
 
 bool FSVONavigationDataGenerator::IsBuildInProgressCheckDirty() const
 {
-    return RunningBoundsDataGenerationElements.Num() || PendingBoundsDataGenerationElements.Num();
+    return RunningBoundsDataGenerationElements.Num() || PendingBoundsDataGenerationElements.Num() || DebouncedDirtyAreas.Num();
 }
 
 int32 FSVONavigationDataGenerator::GetNumRemaningBuildTasks() const
 {
-    return RunningBoundsDataGenerationElements.Num() + PendingBoundsDataGenerationElements.Num();
+    return RunningBoundsDataGenerationElements.Num() + PendingBoundsDataGenerationElements.Num() + DebouncedDirtyAreas.Num();
 }
 
 int32 FSVONavigationDataGenerator::GetNumRunningBuildTasks() const
@@ -199,7 +537,208 @@ int32 FSVONavigationDataGenerator::GetNumRunningBuildTasks() const
     return RunningBoundsDataGenerationElements.Num();
 }
 
-void FSVONavigationDataGenerator::GetSeedLocations( TArray< FVector2D > & seed_locations, UWorld & world ) const
+void FSVONavigationDataGenerator::GetGenerationProgress( TArray< FSVOVolumeGenerationProgressInfo > & progress_infos ) const
+{
+    progress_infos.Reserve( progress_infos.Num() + RunningBoundsDataGenerationElements.Num() + PendingBoundsDataGenerationElements.Num() );
+
+    for ( const auto & element : RunningBoundsDataGenerationElements )
+    {
+        if ( element.ShouldDiscard || !element.BoxNavigationDataGenerator.IsValid() )
+        {
+            continue;
+        }
+
+        auto & progress_info = progress_infos.Add_GetRef( element.BoxNavigationDataGenerator->GetProgress().GetInfo() );
+        progress_info.VolumeBounds = element.VolumeBounds;
+    }
+
+    for ( const auto & pair : PendingBoundsDataGenerationElements )
+    {
+        const auto & element = pair.Value;
+        auto & progress_info = progress_infos.AddDefaulted_GetRef();
+        progress_info.VolumeBounds = element.VolumeBounds;
+        progress_info.ElapsedTime = FPlatformTime::Seconds() - element.QueueTime;
+    }
+}
+
+bool FSVONavigationDataGenerator::IsGeneratingVolume( const FBox & volume_bounds ) const
+{
+    return PendingBoundsDataGenerationElements.Contains( volume_bounds ) || RunningBoundsDataGenerationElements.ContainsByPredicate( [ &volume_bounds ]( const FRunningBoundsDataGenerationElement & element ) {
+        return element.VolumeBounds == volume_bounds && !element.ShouldDiscard;
+    } );
+}
+
+ASVONavigationData * FSVONavigationDataGenerator::GetFinestNavigationData() const
+{
+    auto * world = GetWorld();
+
+    if ( GenerationSettings.OcclusionSource != ESVOOcclusionSource::FinestNavigationData || world == nullptr )
+    {
+        return nullptr;
+    }
+
+    ASVONavigationData * finest_navigation_data = nullptr;
+    auto finest_agent_radius = NavigationData.GetConfig().AgentRadius;
+
+    for ( TActorIterator< ASVONavigationData > iterator( world ); iterator; ++iterator )
+    {
+        const auto agent_radius = iterator->GetConfig().AgentRadius;
+
+        if ( agent_radius < finest_agent_radius )
+        {
+            finest_navigation_data = *iterator;
+            finest_agent_radius = agent_radius;
+        }
+    }
+
+    return finest_navigation_data;
+}
+
+bool FSVONavigationDataGenerator::IsGeneratingAroundInvokersOnly() const
+{
+    auto * world = GetWorld();
+
+    if ( world == nullptr || !world->IsGameWorld() || !NavigationData.SupportsRuntimeGeneration() )
+    {
+        return false;
+    }
+
+    const auto * navigation_system = FNavigationSystem::GetCurrent< UNavigationSystemV1 >( world );
+    return navigation_system != nullptr && navigation_system->IsActiveTilesGenerationEnabled();
+}
+
+TArray< FBox > FSVONavigationDataGenerator::GetInvokerCells( const FBox & volume_bounds ) const
+{
+    const auto * volume_invoker_cells = VolumeInvokerCells.FindByPredicate( [ &volume_bounds ]( const FSVOVolumeInvokerCells & element ) {
+        return element.VolumeBounds == volume_bounds;
+    } );
+
+    return volume_invoker_cells != nullptr && IsGeneratingAroundInvokersOnly()
+               ? volume_invoker_cells->Cells
+               : TArray< FBox >();
+}
+
+void FSVONavigationDataGenerator::UpdateInvokerCells()
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVONavigationDataGenerator_UpdateInvokerCells );
+
+    const auto * navigation_system = FNavigationSystem::GetCurrent< UNavigationSystemV1 >( GetWorld() );
+
+    if ( navigation_system == nullptr )
+    {
+        return;
+    }
+
+    const auto & invokers = navigation_system->GetInvokerLocations();
+    const auto cell_size = NavigationData.InvokerCellSize;
+    TArray< FNavigationDirtyArea > dirty_areas;
+
+    for ( const auto & volume_bounds : RegisteredNavigationBounds )
+    {
+        auto * volume_invoker_cells = VolumeInvokerCells.FindByPredicate( [ &volume_bounds ]( const FSVOVolumeInvokerCells & element ) {
+            return element.VolumeBounds == volume_bounds;
+        } );
+
+        // The data of the whole volume, which can have been loaded with the level, is replaced by the data of the cells the first time
+        const auto is_new_volume = volume_invoker_cells == nullptr;
+
+        if ( is_new_volume )
+        {
+            volume_invoker_cells = &VolumeInvokerCells.Add_GetRef( { volume_bounds, {} } );
+            dirty_areas.Emplace( FNavigationDirtyArea( volume_bounds, 0 ) );
+        }
+
+        TArray< FBox > cells;
+
+        // The cells of the volume inside the generation radius of an invoker
+        for ( const auto & invoker : invokers )
+        {
+            const auto invoker_bounds = volume_bounds.Overlap( FBox::BuildAABB( invoker.Location, FVector( invoker.RadiusMin ) ) );
+
+            if ( !invoker_bounds.IsValid )
+            {
+                continue;
+            }
+
+            const FIntVector min_coords(
+                FMath::FloorToInt( invoker_bounds.Min.X / cell_size ),
+                FMath::FloorToInt( invoker_bounds.Min.Y / cell_size ),
+                FMath::FloorToInt( invoker_bounds.Min.Z / cell_size ) );
+            const FIntVector max_coords(
+                FMath::FloorToInt( invoker_bounds.Max.X / cell_size ),
+                FMath::FloorToInt( invoker_bounds.Max.Y / cell_size ),
+                FMath::FloorToInt( invoker_bounds.Max.Z / cell_size ) );
+
+            for ( auto z = min_coords.Z; z <= max_coords.Z; ++z )
+            {
+                for ( auto y = min_coords.Y; y <= max_coords.Y; ++y )
+                {
+                    for ( auto x = min_coords.X; x <= max_coords.X; ++x )
+                    {
+                        const FBox cell( FVector( x, y, z ) * cell_size, FVector( x + 1, y + 1, z + 1 ) * cell_size );
+
+                        if ( FMath::SphereAABBIntersection( invoker.Location, FMath::Square( invoker.RadiusMin ), cell ) )
+                        {
+                            cells.AddUnique( cell );
+                        }
+                    }
+                }
+            }
+        }
+
+        // The cells already generated are kept until they are out of the removal radius of all the invokers, so they are not generated again and again around the generation radius
+        for ( const auto & cell : volume_invoker_cells->Cells )
+        {
+            if ( invokers.ContainsByPredicate( [ &cell ]( const FNavigationInvokerRaw & invoker ) {
+                     return FMath::SphereAABBIntersection( invoker.Location, FMath::Square( invoker.RadiusMax ), cell );
+                 } ) )
+            {
+                cells.AddUnique( cell );
+            }
+        }
+
+        cells.Sort( []( const FBox & first, const FBox & second ) {
+            if ( first.Min.X != second.Min.X )
+            {
+                return first.Min.X < second.Min.X;
+            }
+            if ( first.Min.Y != second.Min.Y )
+            {
+                return first.Min.Y < second.Min.Y;
+            }
+            return first.Min.Z < second.Min.Z;
+        } );
+
+        if ( is_new_volume || cells == volume_invoker_cells->Cells )
+        {
+            volume_invoker_cells->Cells = MoveTemp( cells );
+            continue;
+        }
+
+        // Only the added and removed cells are rasterized again
+        const auto add_dirty_cells = [ & ]( const TArray< FBox > & added_cells, const TArray< FBox > & other_cells ) {
+            for ( const auto & cell : added_cells )
+            {
+                if ( !other_cells.Contains( cell ) )
+                {
+                    dirty_areas.Emplace( FNavigationDirtyArea( volume_bounds.Overlap( cell ), 0 ) );
+                }
+            }
+        };
+
+        add_dirty_cells( cells, volume_invoker_cells->Cells );
+        add_dirty_cells( volume_invoker_cells->Cells, cells );
+
+        volume_invoker_cells->Cells = MoveTemp( cells );
+    }
+
+    if ( dirty_areas.Num() > 0 )
+    {
+        QueueDirtyAreas( dirty_areas );
+    }
+}
+
+void FSVONavigationDataGenerator::GetSeedLocations( TArray< FVector > & seed_locations, UWorld & world ) const
 {
     // Collect players positions
     for ( FConstPlayerControllerIterator player_iterator = world.GetPlayerControllerIterator(); player_iterator; ++player_iterator )
@@ -208,39 +747,130 @@ void FSVONavigationDataGenerator::GetSeedLocations( TArray< FVector2D > & seed_l
         {
             if ( const auto * pawn = player_controller->GetPawn() )
             {
-                const FVector2D seed_location( pawn->GetActorLocation() );
-                seed_locations.Add( seed_location );
+                seed_locations.Add( pawn->GetActorLocation() );
+            }
+        }
+    }
+
+    // The volumes around the invokers are needed first
+    if ( IsGeneratingAroundInvokersOnly() )
+    {
+        if ( const auto * navigation_system = FNavigationSystem::GetCurrent< UNavigationSystemV1 >( &world ) )
+        {
+            for ( const auto & invoker : navigation_system->GetInvokerLocations() )
+            {
+                seed_locations.Emplace( invoker.Location );
             }
         }
     }
 }
 
-void FSVONavigationDataGenerator::SortPendingBounds()
+void FSVONavigationDataGenerator::UpdatePendingPriorities()
 {
-    if ( UWorld * current_world = GetWorld() )
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVONavigation_UpdatePendingPriorities );
+
+    auto * world = GetWorld();
+
+    if ( world == nullptr || PendingBoundsDataGenerationElements.Num() == 0 )
     {
-        TArray< FVector2D > seed_locations;
-        GetSeedLocations( seed_locations, *current_world );
+        return;
+    }
 
-        if ( seed_locations.Num() == 0 )
+    TArray< FVector > seed_locations;
+    GetSeedLocations( seed_locations, *world );
+
+    if ( seed_locations.Num() == 0 )
+    {
+        seed_locations.Add( TotalNavigationBounds.GetCenter() );
+    }
+
+    const auto leaf_size = GetLeafSize();
+
+    for ( auto & pair : PendingBoundsDataGenerationElements )
+    {
+        auto & element = pair.Value;
+        auto seed_distance = MAX_dbl;
+
+        // The distance is 0 for the volumes which contain a seed location
+        for ( const auto & seed_location : seed_locations )
         {
-            seed_locations.Add( FVector2D( TotalNavigationBounds.GetCenter() ) );
+            seed_distance = FMath::Min( seed_distance, static_cast< double >( element.VolumeBounds.ComputeSquaredDistanceToPoint( seed_location ) ) );
         }
 
-        if ( seed_locations.Num() > 0 )
+        element.EstimatedCost = CostModel.EstimateCost( element.VolumeBounds, GetGeneratedVolume( element.VolumeBounds, element.DirtyBounds ), leaf_size );
+
+        // Weighted shortest job first : the volumes near the seed locations are needed first, and among them the cheapest ones are usable the soonest
+        element.Priority = ( FMath::Sqrt( seed_distance ) + SeedDistanceBias ) * element.EstimatedCost;
+    }
+}
+
+void FSVONavigationDataGenerator::StartTileTasks()
+{
+    auto running_tile_task_count = 0;
+    TArray< FRunningBoundsDataGenerationElement * > waiting_elements;
+
+    for ( auto & element : RunningBoundsDataGenerationElements )
+    {
+        for ( const auto * tile_task : element.TileTasks )
         {
-            for ( auto & element : PendingBoundsDataGenerationElements )
+            if ( !tile_task->IsDone() )
             {
-                FVector2D tile_center_2d = FVector2D( element.VolumeBounds.GetCenter() );
-                for ( const auto & seed_location : seed_locations )
-                {
-                    element.SeedDistance = FMath::Min( element.SeedDistance, FVector2D::DistSquared( tile_center_2d, seed_location ) );
-                }
+                running_tile_task_count++;
             }
+        }
+
+        if ( !element.ShouldDiscard && element.NextTileIndex < element.BoxNavigationDataGenerator->GetTileCount() )
+        {
+            waiting_elements.Add( &element );
+        }
+    }
+
+    waiting_elements.Sort( []( const FRunningBoundsDataGenerationElement & first, const FRunningBoundsDataGenerationElement & second ) {
+        return first.Priority < second.Priority;
+    } );
 
-            PendingBoundsDataGenerationElements.Sort();
+    for ( auto * element : waiting_elements )
+    {
+        const auto tile_count = element->BoxNavigationDataGenerator->GetTileCount();
+
+        for ( ; element->NextTileIndex < tile_count && running_tile_task_count < MaximumTileTaskCount; ++element->NextTileIndex )
+        {
+            TUniquePtr< FSVOTileGeneratorTask > task = MakeUnique< FSVOTileGeneratorTask >( element->BoxNavigationDataGenerator.ToSharedRef(), element->NextTileIndex );
+            task->StartBackgroundTask();
+            element->TileTasks.Add( task.Release() );
+            running_tile_task_count++;
         }
     }
+
+    SET_DWORD_STAT( STAT_SVONavigation_RunningTileTaskCount, running_tile_task_count );
+}
+
+double FSVONavigationDataGenerator::GetGeneratedVolume( const FBox & volume_bounds, const TArray< FBox > & dirty_bounds ) const
+{
+    if ( dirty_bounds.Num() == 0 && !IsGeneratingAroundInvokersOnly() )
+    {
+        return volume_bounds.GetVolume();
+    }
+
+    // The overlapping boxes are counted several times, which is fine for an estimate
+    const auto generated_boxes = dirty_bounds.Num() > 0 ? dirty_bounds : GetInvokerCells( volume_bounds );
+    auto generated_volume = 0.0;
+
+    for ( const auto & generated_box : generated_boxes )
+    {
+        if ( generated_box.Intersect( volume_bounds ) )
+        {
+            generated_volume += generated_box.Overlap( volume_bounds ).GetVolume();
+        }
+    }
+
+    return generated_volume;
+}
+
+float FSVONavigationDataGenerator::GetLeafSize() const
+{
+    // Same as the leaves of the generated data, see FSVOVolumeNavigationDataGenerator and FSVOData::Initialize
+    return NavigationData.GetConfig().AgentRadius * 2.0f * 4.0f;
 }
 
 void FSVONavigationDataGenerator::UpdateNavigationBounds()
@@ -285,31 +915,81 @@ void FSVONavigationDataGenerator::UpdateNavigationBounds()
     }
 }
 
-TArray< FBox > FSVONavigationDataGenerator::ProcessAsyncTasks( const int32 task_to_process_count )
+TArray< FBox > FSVONavigationDataGenerator::ProcessAsyncTasks( const int32 task_to_process_count, const double apply_time_budget )
 {
     const bool has_tasks_at_start = GetNumRemaningBuildTasks() > 0;
 
+    TArray< FBox > finished_boxes;
     int32 processed_tasks_count = 0;
-    // Submit pending tile elements
-    for ( int32 element_index = PendingBoundsDataGenerationElements.Num() - 1; element_index >= 0 && processed_tasks_count < task_to_process_count; element_index-- )
+
+    // The seed locations move, so the priorities are computed again each time, and the priority queue is built from them
+    UpdatePendingPriorities();
+
+    TArray< FSVOPendingVolumePriority > pending_queue;
+    pending_queue.Reserve( PendingBoundsDataGenerationElements.Num() );
+
+    for ( const auto & pair : PendingBoundsDataGenerationElements )
+    {
+        pending_queue.Add( { pair.Key, pair.Value.Priority } );
+    }
+
+    pending_queue.Heapify();
+
+    // Submit the most urgent pending elements. The elements which can't start yet stay pending
+    while ( pending_queue.Num() > 0 && processed_tasks_count < task_to_process_count )
     {
-        FPendingBoundsDataGenerationElement & PendingElement = PendingBoundsDataGenerationElements[ element_index ];
+        FSVOPendingVolumePriority pending_volume;
+        pending_queue.HeapPop( pending_volume, /*bAllowShrinking=*/false );
+
+        FPendingBoundsDataGenerationElement & PendingElement = PendingBoundsDataGenerationElements.FindChecked( pending_volume.VolumeBounds );
         FRunningBoundsDataGenerationElement running_element( PendingElement.VolumeBounds );
+        running_element.QueueTime = PendingElement.QueueTime;
+        running_element.DirtyBounds = PendingElement.DirtyBounds;
+        running_element.Priority = PendingElement.Priority;
+
+        // Discarded elements can still be running, but their results won't be used
+        if ( RunningBoundsDataGenerationElements.ContainsByPredicate( [ &running_element ]( const FRunningBoundsDataGenerationElement & element ) {
+                 return element == running_element && !element.ShouldDiscard;
+             } ) )
+        {
+            continue;
+        }
+
+        if ( IsWaitingForFinestNavigationData( PendingElement.VolumeBounds ) )
+        {
+            continue;
+        }
 
-        if ( RunningBoundsDataGenerationElements.Contains( running_element ) )
+        // No invoker needs the volume anymore, so its data is removed instead of being generated
+        if ( IsGeneratingAroundInvokersOnly() && GetInvokerCells( PendingElement.VolumeBounds ).Num() == 0 )
         {
+            UE_LOG( LogNavigation, Verbose, TEXT( "SVO navigation data of volume %s removed, as no navigation invoker needs it." ), *PendingElement.VolumeBounds.ToString() );
+
+            NavigationData.RemoveDataInBounds( PendingElement.VolumeBounds );
+            finished_boxes.Emplace( PendingElement.VolumeBounds );
+            PendingBoundsDataGenerationElements.Remove( pending_volume.VolumeBounds );
+            processed_tasks_count++;
             continue;
         }
 
-        TUniquePtr< FSVOBoxGeneratorTask > task = MakeUnique< FSVOBoxGeneratorTask >( CreateBoxNavigationGenerator( PendingElement.VolumeBounds ) );
+        const auto box_navigation_data_generator = CreateBoxNavigationGenerator( PendingElement.VolumeBounds, PendingElement.DirtyBounds );
+
+        if ( box_navigation_data_generator->IsUpToDate() )
+        {
+            UE_LOG( LogNavigation, Verbose, TEXT( "SVO navigation data of volume %s is up to date, skipping its generation." ), *PendingElement.VolumeBounds.ToString() );
 
-        running_element.AsyncTask = task.Release();
+            PendingBoundsDataGenerationElements.Remove( pending_volume.VolumeBounds );
+            processed_tasks_count++;
+            continue;
+        }
 
-        running_element.AsyncTask->StartBackgroundTask();
+        running_element.BoxNavigationDataGenerator = box_navigation_data_generator;
+        running_element.GeneratedVolume = GetGeneratedVolume( PendingElement.VolumeBounds, PendingElement.DirtyBounds );
+        running_element.TileTasks.Reserve( box_navigation_data_generator->GetTileCount() );
 
         RunningBoundsDataGenerationElements.Add( running_element );
 
-        PendingBoundsDataGenerationElements.RemoveAt( element_index, 1, /*bAllowShrinking=*/false );
+        PendingBoundsDataGenerationElements.Remove( pending_volume.VolumeBounds );
         processed_tasks_count++;
     }
 
@@ -318,36 +998,135 @@ TArray< FBox > FSVONavigationDataGenerator::ProcessAsyncTasks( const int32 task_
         PendingBoundsDataGenerationElements.Empty( 64 );
     }
 
-    TArray< FBox > finished_boxes;
+    // Each tile is an independent task, so big volumes are generated by all the workers
+    StartTileTasks();
+
+    const auto apply_start_time = FPlatformTime::Seconds();
+    int32 waiting_result_count = 0;
+    int32 leaves_rasterized = 0;
+    int32 leaves_expected = 0;
+    double estimated_remaining_time = 0.0;
 
     for ( int32 index = RunningBoundsDataGenerationElements.Num() - 1; index >= 0; --index )
     {
         // QUICK_SCOPE_CYCLE_COUNTER( STAT_RecastNavMeshGenerator_ProcessTileTasks_FinishedTasks );
 
         FRunningBoundsDataGenerationElement & element = RunningBoundsDataGenerationElements[ index ];
-        check( element.AsyncTask != nullptr );
+
+        if ( element.ShouldDiscard )
+        {
+            // The generator was cancelled, so the tasks finish quickly
+            if ( element.AreTasksDone() )
+            {
+                element.DeleteTasks();
+                RunningBoundsDataGenerationElements.RemoveAtSwap( index, 1, false );
+            }
+
+            continue;
+        }
+
+        {
+            const auto progress_info = element.BoxNavigationDataGenerator->GetProgress().GetInfo();
+            leaves_rasterized += progress_info.LeavesRasterized;
+            leaves_expected += progress_info.LeavesExpected;
+            estimated_remaining_time = FMath::Max( estimated_remaining_time, progress_info.EstimatedRemainingTime );
+        }
+
+        if ( element.AsyncTask == nullptr )
+        {
+            if ( element.NextTileIndex < element.BoxNavigationDataGenerator->GetTileCount() || element.TileTasks.ContainsByPredicate( []( const FSVOTileGeneratorTask * tile_task ) {
+                     return !tile_task->IsDone();
+                 } ) )
+            {
+                continue;
+            }
+
+            for ( auto * tile_task : element.TileTasks )
+            {
+                delete tile_task;
+            }
+            element.TileTasks.Reset();
+
+            // All the tiles are rasterized, stitch them together
+            TUniquePtr< FSVOBoxGeneratorTask > task = MakeUnique< FSVOBoxGeneratorTask >( element.BoxNavigationDataGenerator.ToSharedRef() );
+            element.AsyncTask = task.Release();
+            element.AsyncTask->StartBackgroundTask();
+            continue;
+        }
 
         if ( !element.AsyncTask->IsDone() )
         {
             continue;
         }
 
-        if ( element.ShouldDiscard )
+        // The results are applied on the game thread, so limit the time spent doing it each frame. The remaining results are applied during the next frames
+        if ( apply_time_budget > 0.0 && finished_boxes.Num() > 0 && FPlatformTime::Seconds() - apply_start_time >= apply_time_budget )
         {
+            waiting_result_count++;
             continue;
         }
 
-        auto & box_generator = *element.AsyncTask->GetTask().BoxNavigationDataGenerator;
+        {
+            SCOPE_CYCLE_COUNTER( STAT_SVONavigation_ApplyResults );
 
-        NavigationData.AddVolumeNavigationData( box_generator.GetBoundsNavigationData() );
+            auto & box_generator = *element.AsyncTask->GetTask().BoxNavigationDataGenerator;
+            const auto progress_info = box_generator.GetProgress().GetInfo();
 
-        finished_boxes.Emplace( MoveTemp( element.VolumeBounds ) );
+            if ( box_generator.IsLoadedFromCache() )
+            {
+                UE_LOG( LogNavigation, Verbose, TEXT( "SVO navigation data of volume %s loaded from the generation cache." ), *element.VolumeBounds.ToString() );
+            }
+            else
+            {
+                UE_LOG( LogNavigation,
+                    Verbose,
+                    TEXT( "SVO navigation data of volume %s generated in %.3fs. %d leaves rasterized. Peak memory : %lld bytes, Retained memory : %lld bytes. First pass : %.3fs, Leaf rasterization : %.3fs, Layer build : %.3fs, Parent links : %.3fs, Neighbor links : %.3fs, Clearance field : %.3fs" ),
+                    *element.VolumeBounds.ToString(),
+                    progress_info.ElapsedTime,
+                    progress_info.LeavesRasterized,
+                    progress_info.PeakMemory,
+                    progress_info.RetainedMemory,
+                    progress_info.GetStageTime( ESVOGenerationStage::FirstPass ),
+                    progress_info.GetStageTime( ESVOGenerationStage::LeafRasterization ),
+                    progress_info.GetStageTime( ESVOGenerationStage::LayerBuild ),
+                    progress_info.GetStageTime( ESVOGenerationStage::ParentLinks ),
+                    progress_info.GetStageTime( ESVOGenerationStage::NeighborLinks ),
+                    progress_info.GetStageTime( ESVOGenerationStage::ClearanceField ) );
+
+                SET_MEMORY_STAT( STAT_SVONavigation_LastGenerationPeakMemory, progress_info.PeakMemory );
+                SET_MEMORY_STAT( STAT_SVONavigation_LastGenerationRetainedMemory, progress_info.RetainedMemory );
+                CostModel.AddSample( element.VolumeBounds, element.GeneratedVolume, GetLeafSize(), element.DirtyBounds.Num() == 0, progress_info );
+            }
+
+            // The previous data of the volume stays queryable during the generation, and is replaced here
+            NavigationData.AddVolumeNavigationData( box_generator.GetBoundsNavigationData() );
+        }
+
+        SET_FLOAT_STAT( STAT_SVONavigation_ApplyLatency, ( FPlatformTime::Seconds() - element.QueueTime ) * 1000.0 );
+
+        // Only the paths going through the updated areas must be invalidated. The cached data replaces the whole volume
+        if ( element.DirtyBounds.Num() > 0 && !element.BoxNavigationDataGenerator->IsLoadedFromCache() )
+        {
+            finished_boxes.Append( element.DirtyBounds );
+        }
+        else
+        {
+            finished_boxes.Emplace( element.VolumeBounds );
+        }
 
         delete element.AsyncTask;
         element.AsyncTask = nullptr;
         RunningBoundsDataGenerationElements.RemoveAtSwap( index, 1, false );
     }
 
+    SET_DWORD_STAT( STAT_SVONavigation_PendingGenerationCount, PendingBoundsDataGenerationElements.Num() );
+    SET_DWORD_STAT( STAT_SVONavigation_DebouncedDirtyAreaCount, DebouncedDirtyAreas.Num() );
+    SET_DWORD_STAT( STAT_SVONavigation_RunningGenerationCount, RunningBoundsDataGenerationElements.Num() - waiting_result_count );
+    SET_DWORD_STAT( STAT_SVONavigation_WaitingResultCount, waiting_result_count );
+    SET_DWORD_STAT( STAT_SVONavigation_LeavesRasterized, leaves_rasterized );
+    SET_DWORD_STAT( STAT_SVONavigation_LeavesExpected, leaves_expected );
+    SET_FLOAT_STAT( STAT_SVONavigation_EstimatedRemainingTime, estimated_remaining_time );
+
     const bool has_tasks_at_end = GetNumRemaningBuildTasks() > 0;
     if ( has_tasks_at_start && !has_tasks_at_end )
     {
@@ -358,10 +1137,10 @@ TArray< FBox > FSVONavigationDataGenerator::ProcessAsyncTasks( const int32 task_
     return finished_boxes;
 }
 
-TSharedRef< FSVOVolumeNavigationDataGenerator > FSVONavigationDataGenerator::CreateBoxNavigationGenerator( const FBox & box )
+TSharedRef< FSVOVolumeNavigationDataGenerator > FSVONavigationDataGenerator::CreateBoxNavigationGenerator( const FBox & box, const TArray< FBox > & dirty_bounds )
 {
     // SCOPE_CYCLE_COUNTER(STAT_SVONavigation_CreateBoxNavigationGenerator);
 
-    TSharedRef< FSVOVolumeNavigationDataGenerator > box_navigation_data_generator = MakeShareable( new FSVOVolumeNavigationDataGenerator( *this, box ) );
+    TSharedRef< FSVOVolumeNavigationDataGenerator > box_navigation_data_generator = MakeShareable( new FSVOVolumeNavigationDataGenerator( *this, box, dirty_bounds ) );
     return box_navigation_data_generator;
 }
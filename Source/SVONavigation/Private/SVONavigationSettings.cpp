@@ -5,5 +5,6 @@
 USVONavigationSettings::USVONavigationSettings()
 {
     bNavigationAutoUpdateEnabled = true;
+    bUseGenerationCache = false;
     DefaultRaycasterClass = USVORayCaster_OctreeTraversal::StaticClass();
 }
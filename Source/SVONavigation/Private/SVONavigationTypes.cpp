@@ -4,6 +4,80 @@
 
 const FSVONodeAddress FSVONodeAddress::InvalidAddress;
 
+namespace
+{
+    // The roots are cubes as big as the smallest side of the volume, laid out side by side along the other sides, instead of a single cube as big as the biggest side.
+    // They are made bigger when the volume is so flat or elongated that the grid would contain too many of them
+    bool ComputeRootGrid( int32 & voxel_exponent, FIntVector & root_counts, const float leaf_size, const FBox & volume_bounds )
+    {
+        static constexpr auto MaxRootCount = 4096;
+        // The morton codes are encoded on 21 bits per axis
+        static constexpr auto MaxLeafCountPerAxis = 1 << 21;
+
+        const auto volume_size = volume_bounds.GetSize();
+
+        // At least 2 layers are needed, as the nodes of layer 1 contain whole leaves
+        if ( volume_size.GetMax() <= leaf_size )
+        {
+            return false;
+        }
+
+        voxel_exponent = FMath::Max( 1, FMath::CeilToInt( FMath::Log2( FMath::Max( volume_size.GetMin(), leaf_size ) / leaf_size ) ) );
+
+        while ( true )
+        {
+            const auto root_size = FMath::Pow( 2.0f, voxel_exponent ) * leaf_size;
+
+            root_counts = FIntVector(
+                FMath::Max( 1, FMath::CeilToInt( volume_size.X / root_size ) ),
+                FMath::Max( 1, FMath::CeilToInt( volume_size.Y / root_size ) ),
+                FMath::Max( 1, FMath::CeilToInt( volume_size.Z / root_size ) ) );
+
+            if ( static_cast< int64 >( root_counts.X ) * root_counts.Y * root_counts.Z <= MaxRootCount )
+            {
+                return ( static_cast< int64 >( root_counts.GetMax() ) << voxel_exponent ) <= MaxLeafCountPerAxis;
+            }
+
+            ++voxel_exponent;
+        }
+    }
+}
+
+TArray< TEnumAsByte< ECollisionChannel > > FSVODataGenerationSettings::GetCollisionChannels() const
+{
+    TArray< TEnumAsByte< ECollisionChannel > > collision_channels;
+    collision_channels.Add( CollisionChannel );
+
+    if ( OcclusionSource != ESVOOcclusionSource::PhysicsScene )
+    {
+        return collision_channels;
+    }
+
+    for ( const auto additional_collision_channel : AdditionalCollisionChannels )
+    {
+        if ( collision_channels.Num() == MaxCollisionChannelCount )
+        {
+            break;
+        }
+
+        collision_channels.AddUnique( additional_collision_channel );
+    }
+
+    return collision_channels;
+}
+
+FSVOLeafNodes::FSVOLeafNodes( const FSVOLeafNodes & other ) :
+    LeafNodeSize( other.LeafNodeSize ),
+    SubNodeClearances( other.SubNodeClearances )
+{
+    // A leaf is only flagged as resolved once its sub nodes are written, so the flags are copied before the sub nodes.
+    // A leaf resolved during the copy is then resolved again by the copy, instead of keeping its sub nodes from before the resolution
+    UnresolvedLeaves = other.UnresolvedLeaves;
+    FPlatformMisc::MemoryBarrier();
+    LeafNodes = other.LeafNodes;
+    ChannelSubNodes = other.ChannelSubNodes;
+}
+
 void FSVOLeafNodes::Initialize( const float leaf_size )
 {
     LeafNodeSize = leaf_size;
@@ -12,6 +86,9 @@ void FSVOLeafNodes::Initialize( const float leaf_size )
 void FSVOLeafNodes::Reset()
 {
     LeafNodes.Reset();
+    SubNodeClearances.Reset();
+    UnresolvedLeaves.Reset();
+    ChannelSubNodes.Reset();
 }
 
 FSVONode::FSVONode() :
@@ -30,47 +107,52 @@ FSVONode::FSVONode( const ::MortonCode morton_code ) :
 
 int FSVOLeafNodes::GetAllocatedSize() const
 {
-    return LeafNodes.Num() * sizeof( FSVOLeafNode );
+    return LeafNodes.GetAllocatedSize() + SubNodeClearances.GetAllocatedSize() + UnresolvedLeaves.GetAllocatedSize() + ChannelSubNodes.GetAllocatedSize();
 }
 
 void FSVOLeafNodes::AllocateLeafNodes( const int leaf_count )
 {
-    LeafNodes.Reserve( leaf_count );
+    // Leaf nodes are preallocated so they can be rasterized in parallel, each task writing in its own slots
+    LeafNodes.Reset( leaf_count );
+    LeafNodes.SetNum( leaf_count );
+    UnresolvedLeaves.Reset();
+    ChannelSubNodes.Reset();
 }
 
-void FSVOLeafNodes::AddLeafNode( const LeafIndex leaf_index, const SubNodeIndex sub_node_index, const bool is_occluded )
+void FSVOLeafNodes::ResolveLeaf( const LeafIndex leaf_index, const uint_fast64_t sub_nodes, const uint_fast64_t * channel_sub_nodes, const int32 channel_count ) const
 {
-    if ( leaf_index > LeafNodes.Num() - 1 )
-    {
-        AddEmptyLeafNode();
-    }
+    static_assert( sizeof( uint_fast64_t ) == sizeof( int64 ), "The sub nodes are written atomically as an int64" );
 
-    if ( is_occluded )
+    // Concurrent resolutions of the same leaf write the same sub nodes. The flag is only cleared after they are written, so a leaf seen as resolved has its final sub nodes
+    auto & leaf_node = const_cast< FSVOLeafNode & >( LeafNodes[ leaf_index ] );
+    FPlatformAtomics::InterlockedExchange( reinterpret_cast< volatile int64 * >( &leaf_node.SubNodes ), static_cast< int64 >( sub_nodes ) );
+
+    if ( channel_sub_nodes != nullptr )
     {
-        LeafNodes[ leaf_index ].MarkSubNodeAsOccluded( sub_node_index );
+        auto * leaf_channel_sub_nodes = const_cast< uint_fast64_t * >( ChannelSubNodes.GetData() ) + leaf_index * channel_count;
+
+        for ( auto channel_index = 0; channel_index < channel_count; ++channel_index )
+        {
+            FPlatformAtomics::InterlockedExchange( reinterpret_cast< volatile int64 * >( leaf_channel_sub_nodes + channel_index ), static_cast< int64 >( channel_sub_nodes[ channel_index ] ) );
+        }
     }
-}
 
-void FSVOLeafNodes::AddEmptyLeafNode()
-{
-    LeafNodes.AddDefaulted();
+    FPlatformAtomics::AtomicStore( &UnresolvedLeaves[ leaf_index ], static_cast< int8 >( 0 ) );
 }
 
 FSVOLayer::FSVOLayer() :
-    MaxNodeCount( -1 ),
     NodeSize( 0.0f )
 {
 }
 
-FSVOLayer::FSVOLayer( const int max_node_count, const float node_size ) :
-    MaxNodeCount( max_node_count ),
+FSVOLayer::FSVOLayer( const float node_size ) :
     NodeSize( node_size )
 {
 }
 
 int FSVOLayer::GetAllocatedSize() const
 {
-    return Nodes.Num() * sizeof( FSVONode );
+    return Nodes.GetAllocatedSize() + NodeClearances.GetAllocatedSize();
 }
 
 bool FSVOData::Initialize( const float voxel_size, const FBox & volume_bounds )
@@ -79,41 +161,70 @@ bool FSVOData::Initialize( const float voxel_size, const FBox & volume_bounds )
 
     VolumeBounds = volume_bounds;
 
-    const auto volume_size = volume_bounds.GetSize().GetAbsMax();
-
     const auto leaf_size = voxel_size * 4;
-    const auto voxel_exponent = FMath::CeilToInt( FMath::Log2( volume_size / leaf_size ) );
-    const auto layer_count = voxel_exponent + 1;
+    int32 voxel_exponent;
+    FIntVector root_counts;
 
-    if ( layer_count < 2 )
+    if ( !ComputeRootGrid( voxel_exponent, root_counts, leaf_size, volume_bounds ) )
     {
         bIsValid = false;
         return false;
     }
 
+    const auto layer_count = voxel_exponent + 1;
+
     LeafNodes.Initialize( leaf_size );
 
-    const auto navigation_bounds_size = FMath::Pow( 2.0f, voxel_exponent ) * leaf_size;
+    const auto root_size = FMath::Pow( 2.0f, voxel_exponent ) * leaf_size;
 
     for ( LayerIndex layer_index = 0; layer_index < layer_count; ++layer_index )
     {
-        const auto layer_edge_node_count = FMath::Pow( 2.0f, voxel_exponent - layer_index );
-        const auto layer_max_node_count = layer_edge_node_count * layer_edge_node_count * layer_edge_node_count; //FMath::CeilToInt( FMath::Pow( layer_edge_node_count, 3 ) );
-        const auto layer_voxel_size = navigation_bounds_size / layer_edge_node_count;
+        Layers.Emplace( root_size / FMath::Pow( 2.0f, voxel_exponent - layer_index ) );
+    }
+
+    NavigationBounds = FBox::BuildAABB( volume_bounds.GetCenter(), FVector( root_counts ) * root_size * 0.5f );
 
-        Layers.Emplace( layer_max_node_count, layer_voxel_size );
+    return true;
+}
+
+FBox FSVOData::ComputeNavigationBounds( const float voxel_size, const FBox & volume_bounds )
+{
+    const auto leaf_size = voxel_size * 4;
+    int32 voxel_exponent;
+    FIntVector root_counts;
+
+    if ( !ComputeRootGrid( voxel_exponent, root_counts, leaf_size, volume_bounds ) )
+    {
+        return volume_bounds;
     }
 
-    NavigationBounds = FBox::BuildAABB( volume_bounds.GetCenter(), FVector( navigation_bounds_size * 0.5f ) );
+    const auto root_size = FMath::Pow( 2.0f, voxel_exponent ) * leaf_size;
+    return FBox::BuildAABB( volume_bounds.GetCenter(), FVector( root_counts ) * root_size * 0.5f );
+}
 
-    BlockedNodes.SetNumZeroed( layer_count + 1 );
+FIntVector FSVOData::GetLayerNodeCounts( const LayerIndex layer_index ) const
+{
+    const auto layer_node_size = GetLayer( layer_index ).GetNodeSize();
+    const auto navigation_bounds_size = NavigationBounds.GetSize();
 
-    return true;
+    return FIntVector(
+        FMath::RoundToInt( navigation_bounds_size.X / layer_node_size ),
+        FMath::RoundToInt( navigation_bounds_size.Y / layer_node_size ),
+        FMath::RoundToInt( navigation_bounds_size.Z / layer_node_size ) );
 }
 
-void FSVOData::AddBlockedNode( const LayerIndex layer_index, const NodeIndex node_index )
+void FSVOData::Shrink()
 {
-    BlockedNodes[ layer_index ].Add( node_index );
+    for ( auto & layer : Layers )
+    {
+        layer.Nodes.Shrink();
+        layer.NodeClearances.Shrink();
+    }
+
+    LeafNodes.LeafNodes.Shrink();
+    LeafNodes.SubNodeClearances.Shrink();
+    LeafNodes.UnresolvedLeaves.Shrink();
+    LeafNodes.ChannelSubNodes.Shrink();
 }
 
 FSVOData::FSVOData() :
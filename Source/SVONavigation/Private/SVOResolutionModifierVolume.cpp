@@ -0,0 +1,74 @@
+#include "SVOResolutionModifierVolume.h"
+
+#include <Components/BrushComponent.h>
+#include <Engine/CollisionProfile.h>
+#include <NavigationSystem.h>
+
+ASVOResolutionModifierVolume::ASVOResolutionModifierVolume() :
+    Resolution( ESVOResolution::Coarse ),
+    LastBounds( ForceInit )
+{
+    // Like the navigation bounds volumes, it must not be rasterized itself
+    GetBrushComponent()->SetGenerateOverlapEvents( false );
+    GetBrushComponent()->SetCollisionProfileName( UCollisionProfile::NoCollision_ProfileName );
+}
+
+void ASVOResolutionModifierVolume::PostRegisterAllComponents()
+{
+    Super::PostRegisterAllComponents();
+
+    // The navigation data was generated with the volume where it is when it's loaded, only the later changes make it dirty
+    LastBounds = GetComponentsBoundingBox( true );
+}
+
+void ASVOResolutionModifierVolume::Destroyed()
+{
+    Super::Destroyed();
+
+    if ( auto * navigation_system = FNavigationSystem::GetCurrent< UNavigationSystemV1 >( GetWorld() ) )
+    {
+        if ( LastBounds.IsValid )
+        {
+            navigation_system->AddDirtyArea( LastBounds, ENavigationDirtyFlag::All );
+        }
+    }
+}
+
+#if WITH_EDITOR
+void ASVOResolutionModifierVolume::PostEditMove( const bool finished )
+{
+    Super::PostEditMove( finished );
+
+    if ( finished )
+    {
+        UpdateNavigation();
+    }
+}
+
+void ASVOResolutionModifierVolume::PostEditChangeProperty( FPropertyChangedEvent & property_changed_event )
+{
+    Super::PostEditChangeProperty( property_changed_event );
+
+    UpdateNavigation();
+}
+#endif
+
+void ASVOResolutionModifierVolume::UpdateNavigation()
+{
+    const auto bounds = GetComponentsBoundingBox( true );
+
+    if ( auto * navigation_system = FNavigationSystem::GetCurrent< UNavigationSystemV1 >( GetWorld() ) )
+    {
+        if ( LastBounds.IsValid )
+        {
+            navigation_system->AddDirtyArea( LastBounds, ENavigationDirtyFlag::All );
+        }
+
+        if ( bounds.IsValid && bounds != LastBounds )
+        {
+            navigation_system->AddDirtyArea( bounds, ENavigationDirtyFlag::All );
+        }
+    }
+
+    LastBounds = bounds;
+}
@@ -1,12 +1,18 @@
 #include "SVOVolumeNavigationData.h"
 
+#include "SVOCollisionGeometrySnapshot.h"
 #include "SVOHelpers.h"
 #include "SVONavigationData.h"
+#include "SVONavigationStats.h"
 #include "SVONavigationTypes.h"
 #include "SVOVersion.h"
 
 #include "Engine/OverlapResult.h"
 
+#include <Algo/Unique.h>
+#include <Async/ParallelFor.h>
+#include <Hash/CityHash.h>
+#include <PhysicsEngine/BodySetup.h>
 #include <ThirdParty/libmorton/morton.h>
 
 namespace
@@ -19,11 +25,32 @@ namespace
         { 0, 0, 1 },
         { 0, 0, -1 }
     };
+
+    // Boxes which only touch each other don't overlap, so that aligned voxels of different sizes don't occlude their neighbors
+    bool DoBoxesOverlap( const FBox & first, const FBox & second )
+    {
+        return first.Min.X < second.Max.X && first.Max.X > second.Min.X
+               && first.Min.Y < second.Max.Y && first.Max.Y > second.Min.Y
+               && first.Min.Z < second.Max.Z && first.Max.Z > second.Min.Z;
+    }
+
+    // FCollisionObjectQueryParams::AllObjects only contains the built-in object types, and not the custom object channels of the project
+    FCollisionObjectQueryParams MakeAllObjectTypesQueryParams()
+    {
+        FCollisionObjectQueryParams object_query_params;
+
+        for ( auto channel = 0; channel < ECC_OverlapAll_Deprecated; ++channel )
+        {
+            object_query_params.AddObjectTypesToQuery( static_cast< ECollisionChannel >( channel ) );
+        }
+
+        return object_query_params;
+    }
 }
 
 FSVOVolumeNavigationDataGenerationSettings::FSVOVolumeNavigationDataGenerationSettings() :
     VoxelExtent( 0.0f ),
-    World( nullptr )
+    InputHash( 0 )
 {
 }
 
@@ -35,9 +62,9 @@ FVector FSVOVolumeNavigationData::GetNodePositionFromAddress( const FSVONodeAddr
     {
         // Leaf nodes don't have the same NodeIndex as other nodes. They map to the index of the array of leaf nodes.
         // We must then re-construct the leaf node position based on that leaf node parent.
-        const auto & leaf_nodes = SVOData.GetLeafNodes();
-        const auto & leaf_node = leaf_nodes.GetLeafNode( address.NodeIndex );        
-        const auto & leaf_node_parent_node = SVOData.GetLayer( 1 ).GetNode( leaf_node.Parent.NodeIndex );
+        const auto & leaf_nodes = SVOData->GetLeafNodes();
+        const auto & leaf_node = GetLeafNode( address.NodeIndex );
+        const auto & leaf_node_parent_node = SVOData->GetLayer( 1 ).GetNode( leaf_node.Parent.NodeIndex );
         
         const auto child_index_offset = address.NodeIndex - leaf_node_parent_node.FirstChild.NodeIndex;
         const auto leaf_node_morton_code = FSVOHelpers::GetFirstChildMortonCode( leaf_node_parent_node.MortonCode ) + child_index_offset;
@@ -56,11 +83,11 @@ FVector FSVOVolumeNavigationData::GetNodePositionFromAddress( const FSVONodeAddr
         return sub_node_position;
     }
 
-    const auto & navigation_bounds = SVOData.GetNavigationBounds();
+    const auto & navigation_bounds = SVOData->GetNavigationBounds();
     const auto navigation_bounds_center = navigation_bounds.GetCenter();
     const auto navigation_bounds_extent = navigation_bounds.GetExtent();
 
-    const auto & layer = SVOData.GetLayer( address.LayerIndex );
+    const auto & layer = SVOData->GetLayer( address.LayerIndex );
     const auto layer_node_size = layer.GetNodeSize();
     const auto layer_node_extent = layer.GetNodeExtent();
     const auto & node = layer.GetNode( address.NodeIndex );
@@ -78,9 +105,9 @@ FVector FSVOVolumeNavigationData::GetNodePositionFromLayerAndMortonCode( const L
         return GetLeafNodePositionFromMortonCode( morton_code );
     }
 
-    const auto & layer = SVOData.GetLayer( layer_index );
+    const auto & layer = SVOData->GetLayer( layer_index );
     const auto layer_node_extent = layer.GetNodeExtent();
-    const auto & navigation_bounds = SVOData.GetNavigationBounds();
+    const auto & navigation_bounds = SVOData->GetNavigationBounds();
     const auto navigation_bounds_center = navigation_bounds.GetCenter();
     const auto navigation_bounds_extent = navigation_bounds.GetExtent();
     const auto layer_node_size = layer.GetNodeSize();
@@ -91,10 +118,10 @@ FVector FSVOVolumeNavigationData::GetNodePositionFromLayerAndMortonCode( const L
 
 FVector FSVOVolumeNavigationData::GetLeafNodePositionFromMortonCode( const MortonCode morton_code ) const
 {
-    const auto & navigation_bounds = SVOData.GetNavigationBounds();
+    const auto & navigation_bounds = SVOData->GetNavigationBounds();
     const auto navigation_bounds_center = navigation_bounds.GetCenter();
     const auto navigation_bounds_extent = navigation_bounds.GetExtent();
-    const auto & leaf_nodes = SVOData.GetLeafNodes();
+    const auto & leaf_nodes = SVOData->GetLeafNodes();
     const auto leaf_node_extent = leaf_nodes.GetLeafNodeExtent();
     const auto leaf_node_size = leaf_nodes.GetLeafNodeSize();
     const auto morton_coords = FSVOHelpers::GetVectorFromMortonCode( morton_code );
@@ -103,9 +130,50 @@ FVector FSVOVolumeNavigationData::GetLeafNodePositionFromMortonCode( const Morto
     return leaf_node_position;
 }
 
-bool FSVOVolumeNavigationData::GetNodeAddressFromPosition( FSVONodeAddress & node_address, const FVector & position ) const
+FSVOLeafNode FSVOVolumeNavigationData::GetLeafNodeForChannels( const LeafIndex leaf_index, const uint32 channel_mask ) const
+{
+    auto leaf_node = GetLeafNode( leaf_index );
+    const auto channel_count = CollisionChannels.Num();
+    const auto all_channels = static_cast< uint32 >( ( 1ULL << channel_count ) - 1 );
+
+    // The sub nodes of the leaf are the union of the sub nodes of all the channels
+    if ( channel_count <= 1 || ( channel_mask & all_channels ) == all_channels )
+    {
+        return leaf_node;
+    }
+
+    const auto * channel_sub_nodes = SVOData->GetLeafNodes().ChannelSubNodes.GetData() + leaf_index * channel_count;
+    leaf_node.SubNodes = 0;
+
+    for ( auto channel_index = 0; channel_index < channel_count; ++channel_index )
+    {
+        if ( ( channel_mask & ( 1U << channel_index ) ) != 0 )
+        {
+            leaf_node.SubNodes |= channel_sub_nodes[ channel_index ];
+        }
+    }
+
+    return leaf_node;
+}
+
+uint32 FSVOVolumeNavigationData::GetCollisionChannelMask( const TArray< TEnumAsByte< ECollisionChannel > > & collision_channels ) const
+{
+    uint32 channel_mask = 0;
+
+    for ( auto channel_index = 0; channel_index < CollisionChannels.Num(); ++channel_index )
+    {
+        if ( collision_channels.Contains( CollisionChannels[ channel_index ] ) )
+        {
+            channel_mask |= 1U << channel_index;
+        }
+    }
+
+    return channel_mask != 0 ? channel_mask : MAX_uint32;
+}
+
+bool FSVOVolumeNavigationData::GetNodeAddressFromPosition( FSVONodeAddress & node_address, const FVector & position, const uint32 channel_mask ) const
 {
-    const auto & navigation_bounds = SVOData.GetNavigationBounds();
+    const auto & navigation_bounds = SVOData->GetNavigationBounds();
 
     if ( !navigation_bounds.IsInside( position ) )
     {
@@ -125,11 +193,25 @@ bool FSVOVolumeNavigationData::GetNodeAddressFromPosition( FSVONodeAddress & nod
 
     const auto layer_count = GetLayerCount();
     LayerIndex layer_index = layer_count - 1;
-    NodeIndex nodeIndex = 0;
+
+    // The roots are sorted by morton code, so the one containing the position is found directly
+    const auto root_size = SVOData->GetLayer( layer_index ).GetNodeSize();
+    const FIntVector root_coords(
+        FMath::FloorToInt( local_position.X / root_size ),
+        FMath::FloorToInt( local_position.Y / root_size ),
+        FMath::FloorToInt( local_position.Z / root_size ) );
+    const auto root_node_index = GetNodeIndexFromMortonCode( layer_index, FSVOHelpers::GetMortonCodeFromVector( root_coords ) );
+
+    if ( root_node_index == INDEX_NONE )
+    {
+        return false;
+    }
+
+    NodeIndex nodeIndex = root_node_index;
 
     while ( layer_index >= 0 && layer_index < layer_count )
     {
-        const auto & layer = SVOData.GetLayer( layer_index );
+        const auto & layer = SVOData->GetLayer( layer_index );
         const auto & layer_nodes = layer.GetNodes();
         const auto voxel_size = layer.GetNodeSize();
 
@@ -164,8 +246,8 @@ bool FSVOVolumeNavigationData::GetNodeAddressFromPosition( FSVONodeAddress & nod
             // If this is a leaf node, we need to find our subnode
             if ( layer_index == 0 )
             {
-                const auto & leaf_nodes = SVOData.GetLeafNodes();
-                const auto & leaf = leaf_nodes.GetLeafNode( node.FirstChild.NodeIndex );
+                const auto & leaf_nodes = SVOData->GetLeafNodes();
+                const auto leaf = GetLeafNodeForChannels( node.FirstChild.NodeIndex, channel_mask );
 
                 // We need to calculate the node local position to get the morton code for the leaf
                 // The world position of the 0 node
@@ -208,14 +290,14 @@ bool FSVOVolumeNavigationData::GetNodeAddressFromPosition( FSVONodeAddress & nod
     return false;
 }
 
-void FSVOVolumeNavigationData::GetNodeNeighbors( TArray< FSVONodeAddress > & neighbors, const FSVONodeAddress & node_address ) const
+void FSVOVolumeNavigationData::GetNodeNeighbors( TArray< FSVONodeAddress > & neighbors, const FSVONodeAddress & node_address, const uint32 channel_mask ) const
 {
     QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_GetNeighbors );
 
     const auto & node = GetNodeFromAddress( node_address );
     if ( node_address.LayerIndex == 0 && node.FirstChild.IsValid() )
     {
-        GetLeafNeighbors( neighbors, node_address );
+        GetLeafNeighbors( neighbors, node_address, channel_mask );
         return;
     }
 
@@ -283,6 +365,12 @@ void FSVOVolumeNavigationData::GetNodeNeighbors( TArray< FSVONodeAddress > & nei
                     first_child_address.NodeIndex += child_index;
                     const auto & child_node = GetNodeFromAddress( first_child_address );
 
+                    // The children outside of the volume bounds were not rasterized
+                    if ( !IsNodeInVolumeBounds( first_child_address.LayerIndex, child_node.MortonCode ) )
+                    {
+                        continue;
+                    }
+
                     if ( child_node.HasChildren() ) // If it has children, add them to the working set to keep going down
                     {
                         neighbor_addresses_working_set.Emplace( first_child_address );
@@ -323,7 +411,7 @@ void FSVOVolumeNavigationData::GetNodeNeighbors( TArray< FSVONodeAddress > & nei
                 {
                     // Each of the childnodes
                     auto first_child_address = neighbor.FirstChild;
-                    const auto & leaf_node = SVOData.GetLeafNodes().GetLeafNode( first_child_address.NodeIndex );
+                    const auto leaf_node = GetLeafNodeForChannels( first_child_address.NodeIndex, channel_mask );
 
                     first_child_address.LayerIndex = 0;
                     first_child_address.NodeIndex = this_address.NodeIndex;
@@ -353,8 +441,8 @@ float FSVOVolumeNavigationData::GetNodeExtentFromNodeAddress( const FSVONodeAddr
 {
     if ( node_address.LayerIndex == 0 )
     {
-        const auto & leaf_nodes = SVOData.GetLeafNodes();
-        const auto & leaf_node = leaf_nodes.GetLeafNode( node_address.NodeIndex );
+        const auto & leaf_nodes = SVOData->GetLeafNodes();
+        const auto & leaf_node = GetLeafNode( node_address.NodeIndex );
         if ( leaf_node.IsCompletelyFree() )
         {
             return leaf_nodes.GetLeafNodeExtent();
@@ -363,15 +451,22 @@ float FSVOVolumeNavigationData::GetNodeExtentFromNodeAddress( const FSVONodeAddr
         return leaf_nodes.GetLeafSubNodeExtent();
     }
 
-    return SVOData.GetLayer( node_address.LayerIndex ).GetNodeExtent();
+    return SVOData->GetLayer( node_address.LayerIndex ).GetNodeExtent();
 }
 
 TOptional< FNavLocation > FSVOVolumeNavigationData::GetRandomPoint() const
 {
     TArray< FSVONodeAddress > non_occluded_nodes;
-    const FSVONodeAddress top_most_node_address( GetLayerCount(), 0, 0 );
+    const LayerIndex top_layer_index = GetLayerCount() - 1;
+    const auto & top_layer = SVOData->GetLayer( top_layer_index );
 
-    GetFreeNodesFromNodeAddress( top_most_node_address, non_occluded_nodes );
+    for ( NodeIndex node_index = 0; node_index < static_cast< uint32 >( top_layer.GetNodeCount() ); ++node_index )
+    {
+        if ( IsNodeInVolumeBounds( top_layer_index, top_layer.GetNode( node_index ).MortonCode ) )
+        {
+            GetFreeNodesFromNodeAddress( FSVONodeAddress( top_layer_index, node_index ), non_occluded_nodes );
+        }
+    }
 
     if ( non_occluded_nodes.Num() == 0 )
     {
@@ -388,390 +483,1801 @@ TOptional< FNavLocation > FSVOVolumeNavigationData::GetRandomPoint() const
     return FNavLocation( random_point_in_node, random_node.GetNavNodeRef() );
 }
 
-void FSVOVolumeNavigationData::GenerateNavigationData( const FBox & volume_bounds, const FSVOVolumeNavigationDataGenerationSettings & generation_settings )
+bool FSVOVolumeNavigationData::IsBoxOccluded( const FBox & box, const bool resolve_leaves ) const
 {
-    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_GenerateNavigationData );
-
-    Settings = generation_settings;
-    VolumeBounds = volume_bounds;
-
-    const auto voxel_extent = Settings.VoxelExtent;
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_IsBoxOccluded );
 
-    if ( !SVOData.Initialize( voxel_extent, VolumeBounds ) )
+    // Nothing was rasterized outside of the volume bounds and of the invoker cells
+    if ( !SVOData->IsValid() || !box.IsInsideOrOn( VolumeBounds ) || !IsBoxInInvokerCells( box ) )
     {
-        return;
+        return true;
     }
 
-    const auto layer_count = SVOData.GetLayerCount();
+    // Only test the roots the box overlaps, found from their coordinates in the grid of roots
+    const LayerIndex top_layer_index = GetLayerCount() - 1;
+    const auto root_size = SVOData->GetLayer( top_layer_index ).GetNodeSize();
+    const auto & navigation_bounds = SVOData->GetNavigationBounds();
+    const auto root_max_coordinates = SVOData->GetLayerNodeCounts( top_layer_index ) - FIntVector( 1 );
+
+    const auto get_coordinates = [ & ]( const FVector & position ) {
+        const auto local_position = ( position - navigation_bounds.Min ) / root_size;
+        return FIntVector(
+            FMath::Clamp( FMath::FloorToInt( local_position.X ), 0, root_max_coordinates.X ),
+            FMath::Clamp( FMath::FloorToInt( local_position.Y ), 0, root_max_coordinates.Y ),
+            FMath::Clamp( FMath::FloorToInt( local_position.Z ), 0, root_max_coordinates.Z ) );
+    };
 
-    FirstPassRasterization();
+    const auto min_coordinates = get_coordinates( box.Min );
+    const auto max_coordinates = get_coordinates( box.Max );
 
+    for ( auto z = min_coordinates.Z; z <= max_coordinates.Z; ++z )
     {
-        QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_AllocateLeafNodes );
-        const auto leaf_count = SVOData.GetLayerBlockedNodes( 0 ).Num() * 8;
-        SVOData.GetLeafNodes().AllocateLeafNodes( leaf_count );
-    }
-
-    TMap< LeafIndex, MortonCode > leaf_index_to_parent_morton_code;
-    RasterizeInitialLayer( leaf_index_to_parent_morton_code );
+        for ( auto y = min_coordinates.Y; y <= max_coordinates.Y; ++y )
+        {
+            for ( auto x = min_coordinates.X; x <= max_coordinates.X; ++x )
+            {
+                const auto node_index = GetNodeIndexFromMortonCode( top_layer_index, FSVOHelpers::GetMortonCodeFromVector( FIntVector( x, y, z ) ) );
 
-    for ( LayerIndex layer_index = 1; layer_index < layer_count; ++layer_index )
-    {
-        RasterizeLayer( layer_index );
+                if ( node_index != INDEX_NONE && IsNodeOccludedInBox( top_layer_index, node_index, box, resolve_leaves ) )
+                {
+                    return true;
+                }
+            }
+        }
     }
 
-    BuildParentLinkForLeafNodes( leaf_index_to_parent_morton_code );
+    return false;
+}
+
+float FSVOVolumeNavigationData::GetNodeClearanceFromAddress( const FSVONodeAddress & node_address ) const
+{
+    const auto & leaf_nodes = SVOData->GetLeafNodes();
+    const auto clearance_unit = leaf_nodes.GetLeafSubNodeExtent();
 
-    for ( LayerIndex layer_index = layer_count - 2; layer_index != static_cast< LayerIndex >( -1 ); --layer_index )
+    if ( node_address.LayerIndex == 0 && GetNodeFromAddress( node_address ).HasChildren() )
     {
-        BuildNeighborLinks( layer_index );
+        const auto sub_node_clearance_index = node_address.NodeIndex * 64 + node_address.SubNodeIndex;
+        return leaf_nodes.SubNodeClearances.IsValidIndex( sub_node_clearance_index )
+                   ? leaf_nodes.SubNodeClearances[ sub_node_clearance_index ] * clearance_unit
+                   : MAX_flt;
     }
 
-    SVOData.bIsValid = true;
+    const auto & node_clearances = SVOData->GetLayer( node_address.LayerIndex ).NodeClearances;
+    return node_clearances.IsValidIndex( node_address.NodeIndex )
+               ? node_clearances[ node_address.NodeIndex ] * clearance_unit
+               : MAX_flt;
 }
 
-void FSVOVolumeNavigationData::Serialize( FArchive & archive, const ESVOVersion version )
+bool FSVOVolumeNavigationData::IsNodeOccludedInBox( const LayerIndex layer_index, const NodeIndex node_index, const FBox & box, const bool resolve_leaves ) const
 {
-    // when writing, write a zero here for now.  will come back and fill it in later.
-    auto svo_size_bytes = 0;
-    const auto svo_size_position = archive.Tell();
+    const auto & layer = SVOData->GetLayer( layer_index );
+    const auto & node = layer.GetNode( node_index );
 
-    archive << svo_size_bytes;
+    // Nodes without children are free
+    if ( !node.HasChildren() || !DoBoxesOverlap( FBox::BuildAABB( GetNodePositionFromLayerAndMortonCode( layer_index, node.MortonCode ), FVector( layer.GetNodeExtent() ) ), box ) )
+    {
+        return false;
+    }
 
-    if ( archive.IsLoading() )
+    if ( layer_index > 0 )
     {
-        if ( version < ESVOVersion::MinCompatible )
+        for ( NodeIndex child_index = 0; child_index < 8; ++child_index )
         {
-            // incompatible, just skip over this data
-            archive.Seek( svo_size_position + svo_size_bytes );
-            return;
+            if ( IsNodeOccludedInBox( node.FirstChild.LayerIndex, node.FirstChild.NodeIndex + child_index, box, resolve_leaves ) )
+            {
+                return true;
+            }
         }
+
+        return false;
     }
 
-    archive << VolumeBounds;
-    archive << SVOData;
-    archive << VolumeNavigationQueryFilter;
-    archive << bInNavigationDataChunk;
+    const auto & leaf_nodes = SVOData->GetLeafNodes();
 
-    if ( archive.IsSaving() )
+    if ( !resolve_leaves && !leaf_nodes.IsLeafResolved( node.FirstChild.NodeIndex ) )
     {
-        const auto current_position = archive.Tell();
-
-        svo_size_bytes = current_position - svo_size_position;
-
-        archive.Seek( svo_size_position );
-        archive << svo_size_bytes;
-        archive.Seek( current_position );
+        return true;
     }
-}
-
-void FSVOVolumeNavigationData::Reset()
-{
-    VolumeBounds.Init();
-    SVOData.Reset();
-}
 
-bool FSVOVolumeNavigationData::IsPositionOccluded( const FVector & position, const float box_extent ) const
-{
-    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_IsPositionOccluded );
-    TArray< FOverlapResult > overlap_results;
-    const auto result = Settings.World->OverlapMultiByChannel(  
-        overlap_results,
-        position,
-        FQuat::Identity,
-        Settings.GenerationSettings.CollisionChannel,
-        FCollisionShape::MakeBox( FVector( box_extent + Settings.GenerationSettings.Clearance ) ),
-        Settings.GenerationSettings.CollisionQueryParameters );
+    const auto & leaf_node = GetLeafNode( node.FirstChild.NodeIndex );
 
-    if ( !result )
+    if ( leaf_node.IsCompletelyOccluded() )
     {
-        return false;
+        return true;
     }
 
-    return overlap_results.FindByPredicate( []( const FOverlapResult & overlap_result ) {
-        return overlap_result.GetComponent()->CanEverAffectNavigation();
-    } ) != nullptr;
-}
+    const auto leaf_sub_node_size = leaf_nodes.GetLeafSubNodeSize();
+    const auto leaf_sub_node_extent = leaf_nodes.GetLeafSubNodeExtent();
+    const auto location = GetLeafNodePositionFromMortonCode( node.MortonCode ) - leaf_nodes.GetLeafNodeExtent();
 
-void FSVOVolumeNavigationData::FirstPassRasterization()
-{
-    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_FirstPassRasterization );
+    for ( SubNodeIndex sub_node_index = 0; sub_node_index < 64; ++sub_node_index )
     {
-        const auto & layer = SVOData.GetLayer( 1 );
-        const auto layer_max_node_count = layer.GetMaxNodeCount();
-        const auto layer_node_extent = layer.GetNodeExtent();        
-
-        for ( MortonCode node_index = 0; node_index < layer_max_node_count; ++node_index )
+        if ( !leaf_node.IsSubNodeOccluded( sub_node_index ) )
         {
-            const auto position = GetNodePositionFromLayerAndMortonCode( 1, node_index );
-            
-            if ( IsPositionOccluded( position, layer_node_extent ) )
-            {
-                SVOData.AddBlockedNode( 0, node_index );
-            }
+            continue;
         }
-    }
 
-    {
-        for ( int32 layer_index = 1; layer_index < GetLayerCount(); layer_index++ )
+        const auto sub_node_position = location + FSVOHelpers::GetVectorFromMortonCode( sub_node_index ) * leaf_sub_node_size + leaf_sub_node_extent;
+
+        if ( DoBoxesOverlap( FBox::BuildAABB( sub_node_position, FVector( leaf_sub_node_extent ) ), box ) )
         {
-            const auto & parent_layer_blocked_nodes = SVOData.GetLayerBlockedNodes( layer_index - 1 );
-            for ( const MortonCode morton_code : parent_layer_blocked_nodes )
-            {
-                SVOData.AddBlockedNode( layer_index, FSVOHelpers::GetParentMortonCode( morton_code ) );
-            }
+            return true;
         }
     }
+
+    return false;
 }
 
-void FSVOVolumeNavigationData::RasterizeLeaf( const FVector & node_position, const LeafIndex leaf_index )
+void FSVOVolumeNavigationData::GenerateNavigationData( const FBox & volume_bounds, const FSVOVolumeNavigationDataGenerationSettings & generation_settings )
 {
-    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_RasterizeLeaf );
-
-    const auto leaf_node_extent = SVOData.GetLeafNodes().GetLeafNodeExtent();
-    const auto leaf_sub_node_size = SVOData.GetLeafNodes().GetLeafSubNodeSize();
-    const auto leaf_sub_node_extent = SVOData.GetLeafNodes().GetLeafSubNodeExtent();
-    const auto location = node_position - leaf_node_extent;
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_GenerateNavigationData );
 
-    for ( SubNodeIndex sub_node_index = 0; sub_node_index < 64; sub_node_index++ )
+    if ( !BeginGeneration( volume_bounds, generation_settings ) )
     {
-        const auto morton_coords = FSVOHelpers::GetVectorFromMortonCode( sub_node_index );
-        const auto leaf_node_location = location + morton_coords * leaf_sub_node_size + leaf_sub_node_extent;
-        const bool is_leaf_occluded = IsPositionOccluded( leaf_node_location, leaf_sub_node_extent );
-
-        SVOData.GetLeafNodes().AddLeafNode( leaf_index, sub_node_index, is_leaf_occluded );
+        return;
     }
+
+    TArray< FSVOVolumeNavigationDataTile > tiles;
+    tiles.SetNum( GetTileCount() );
+
+    ParallelFor( tiles.Num(), [ & ]( const int32 tile_index ) {
+        RasterizeTile( tiles[ tile_index ], tile_index );
+    } );
+
+    FinishGeneration( tiles );
 }
 
-void FSVOVolumeNavigationData::RasterizeInitialLayer( TMap< LeafIndex, MortonCode > & leaf_index_to_layer_one_node_index_map )
+bool FSVOVolumeNavigationData::BeginGeneration( const FBox & volume_bounds, const FSVOVolumeNavigationDataGenerationSettings & generation_settings )
 {
-    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_RasterizeInitialLayer );
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_BeginGeneration );
 
-    auto & layer_zero = SVOData.GetLayer( 0 );
-    auto & layer_zero_nodes = layer_zero.GetNodes();
+    Settings = generation_settings;
+    VolumeBounds = volume_bounds;
+    InputHash = Settings.InputHash;
+    InvokerCells = Settings.InvokerCells;
+    CollisionChannels = Settings.GenerationSettings.GetCollisionChannels();
 
-    LeafIndex leaf_index = 0;
-    const auto & layer_zero_blocked_nodes = SVOData.GetLayerBlockedNodes( 0 );
-    const auto layer_one_blocked_node_count = layer_zero_blocked_nodes.Num();
-    layer_zero_nodes.Reserve( layer_one_blocked_node_count * 8 );
+    const auto voxel_extent = Settings.VoxelExtent;
 
-    const auto layer_max_node_count = layer_zero.GetMaxNodeCount();
+    // The previous data can still be shared with copies of this data, so it is replaced instead of being modified
+    SVOData = MakeShared< FSVOData, ESPMode::ThreadSafe >();
 
-    auto & leaf_nodes = SVOData.GetLeafNodes();
-    const auto leaf_node_extent = leaf_nodes.GetLeafNodeExtent();
+    if ( !SVOData->Initialize( voxel_extent, VolumeBounds ) )
+    {
+        EndGeneration();
+        return false;
+    }
+
+    // The tiles are the nodes of the highest layer which are not bigger than the tile size. Layer 1 is the lowest possible, as its nodes contain whole leaves
+    const LayerIndex top_layer_index = GetLayerCount() - 1;
+    TileLayerIndex = top_layer_index;
 
-    for ( NodeIndex node_index = 0; node_index < layer_max_node_count; node_index++ )
+    if ( Settings.GenerationSettings.TileSize > 0.0f )
     {
-        const auto parent_morton_code = FSVOHelpers::GetParentMortonCode( node_index );
-        const auto is_blocked = layer_zero_blocked_nodes.Contains( parent_morton_code );
+        TileLayerIndex = 1;
 
-        if ( !is_blocked )
+        while ( TileLayerIndex < top_layer_index && SVOData->GetLayer( TileLayerIndex + 1 ).GetNodeSize() <= Settings.GenerationSettings.TileSize )
         {
-            continue;
+            ++TileLayerIndex;
         }
+    }
+
+    // The nodes of the tile layer outside of the volume bounds or of the invoker cells have nothing to rasterize, so they don't get a tile
+    TileMortonCodes.Reset();
+    GetLayerNodesInBounds( TileMortonCodes, TileLayerIndex, InvokerCells.Num() > 0 ? InvokerCells : TArray< FBox > { VolumeBounds } );
+
+    if ( auto * progress = GetGenerationProgress() )
+    {
+        progress->SetTileCount( GetTileCount() );
+    }
+
+    return true;
+}
 
-        auto & layer_zero_node = layer_zero_nodes.Emplace_GetRef();
-        layer_zero_node.MortonCode = node_index;
+void FSVOVolumeNavigationData::RasterizeTile( FSVOVolumeNavigationDataTile & tile, const int32 tile_index ) const
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_RasterizeTile );
 
-        const auto leaf_node_position = GetLeafNodePositionFromMortonCode( layer_zero_node.MortonCode );
+    // The tiles are sorted by the morton codes of their nodes
+    const auto tile_morton_code = TileMortonCodes[ tile_index ];
 
-        leaf_index_to_layer_one_node_index_map.Add( leaf_index, parent_morton_code );
+    {
+        FSVOGenerationStageScope stage_scope( GetGenerationProgress(), ESVOGenerationStage::FirstPass );
 
-        if ( IsPositionOccluded( leaf_node_position, leaf_node_extent ) )
+        if ( Settings.GenerationSettings.bUseHierarchicalRasterization )
         {
-            RasterizeLeaf( leaf_node_position, leaf_index );
-            layer_zero_node.FirstChild.LayerIndex = 0;
-            layer_zero_node.FirstChild.NodeIndex = leaf_index;
-            layer_zero_node.FirstChild.SubNodeIndex = 0;
+            HierarchicalRasterization( tile.LayerOneBlockedNodes, TileLayerIndex, tile_morton_code );
         }
         else
         {
-            leaf_nodes.AddEmptyLeafNode();
-            layer_zero_node.FirstChild.Invalidate();
+            // The nodes of layer 1 inside the tile have contiguous morton codes
+            const auto layer_node_extent = SVOData->GetLayer( 1 ).GetNodeExtent();
+            const MortonCode layer_node_count_per_tile = 1ULL << ( 3 * ( TileLayerIndex - 1 ) );
+            const auto first_morton_code = tile_morton_code * layer_node_count_per_tile;
+
+            for ( MortonCode node_index = first_morton_code; node_index < first_morton_code + layer_node_count_per_tile; ++node_index )
+            {
+                if ( IsGenerationCancelled() )
+                {
+                    return;
+                }
+
+                if ( !IsNodeInVolumeBounds( 1, node_index ) )
+                {
+                    continue;
+                }
+
+                const auto position = GetNodePositionFromLayerAndMortonCode( 1, node_index );
+
+                if ( IsPositionOccluded( position, layer_node_extent ) )
+                {
+                    tile.LayerOneBlockedNodes.Add( node_index );
+                }
+            }
         }
+    }
+
+    RasterizeTileLeaves( tile );
 
-        leaf_index++;
+    if ( auto * progress = GetGenerationProgress() )
+    {
+        progress->OnTileDone();
     }
 }
 
-void FSVOVolumeNavigationData::RasterizeLayer( const LayerIndex layer_index )
+void FSVOVolumeNavigationData::RasterizeTileLeaves( FSVOVolumeNavigationDataTile & tile ) const
 {
-    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_RasterizeLayer );
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_RasterizeTileLeaves );
 
-    auto & layer = SVOData.GetLayer( layer_index );
-    auto & layer_nodes = layer.GetNodes();
-    const auto & layer_blocked_nodes = SVOData.GetLayerBlockedNodes( layer_index );
+    auto * progress = GetGenerationProgress();
+    FSVOGenerationStageScope stage_scope( progress, ESVOGenerationStage::LeafRasterization );
 
-    checkf( layer_index > 0 && layer_index < GetLayerCount(), TEXT( "layer_index is out of bounds" ) );
+    const auto layer_one_blocked_node_count = tile.LayerOneBlockedNodes.Num();
+    const auto layer_one_node_extent = SVOData->GetLayer( 1 ).GetNodeExtent();
+    const auto leaf_node_extent = SVOData->GetLeafNodes().GetLeafNodeExtent();
+    const auto rasterize_leaves_lazily = Settings.GenerationSettings.bRasterizeLeavesLazily;
+    tile.LeafSubNodes.SetNumZeroed( layer_one_blocked_node_count * 8 );
+    tile.OccludedLeaves.SetNumZeroed( layer_one_blocked_node_count * 8 );
 
-    layer_nodes.Reserve( layer_blocked_nodes.Num() * 8 );
+    if ( rasterize_leaves_lazily )
+    {
+        tile.UnresolvedLeaves.SetNumZeroed( layer_one_blocked_node_count * 8 );
+    }
 
-    const auto layer_max_node_count = layer.GetMaxNodeCount();
+    const auto channel_count = CollisionChannels.Num();
+    const auto has_several_channels = channel_count > 1;
 
-    for ( NodeIndex node_index = 0; node_index < layer_max_node_count; node_index++ )
+    if ( has_several_channels )
     {
-        const auto is_blocked = layer_blocked_nodes.Contains( FSVOHelpers::GetParentMortonCode( node_index ) );
+        tile.LeafChannelSubNodes.SetNumZeroed( layer_one_blocked_node_count * 8 * channel_count );
+    }
 
-        if ( !is_blocked )
+    // The leaves which are completely occluded or not resolved yet are completely occluded for all the channels
+    const auto occlude_all_channels = [ & ]( const int32 tile_leaf_index ) {
+        for ( auto channel_index = 0; has_several_channels && channel_index < channel_count; ++channel_index )
         {
-            continue;
+            tile.LeafChannelSubNodes[ tile_leaf_index * channel_count + channel_index ] = ~static_cast< uint_fast64_t >( 0 );
         }
+    };
 
-        const auto new_node_index = layer_nodes.Emplace();
-
-        auto & layer_node = layer_nodes[ new_node_index ];
-        layer_node.MortonCode = node_index;
+    if ( progress != nullptr )
+    {
+        progress->AddExpectedLeaves( layer_one_blocked_node_count * 8 );
+    }
 
-        const auto child_layer_index = layer_index - 1;
-        const auto first_child_morton_code = FSVOHelpers::GetFirstChildMortonCode( layer_node.MortonCode );
-        const auto child_index_from_code = GetNodeIndexFromMortonCode( child_layer_index, first_child_morton_code );
+    // Each blocked node of layer 1 writes the results of its 8 leaves, so they can be rasterized in parallel
+    ParallelFor( layer_one_blocked_node_count, [ & ]( const int32 blocked_node_index ) {
+        if ( IsGenerationCancelled() )
+        {
+            return;
+        }
 
-        auto & first_child = layer_node.FirstChild;
+        const auto morton_code = tile.LayerOneBlockedNodes[ blocked_node_index ];
+        const auto first_child_morton_code = FSVOHelpers::GetFirstChildMortonCode( morton_code );
+        const auto is_coarse = IsCoarseResolution( FBox::BuildAABB( GetNodePositionFromLayerAndMortonCode( 1, morton_code ), FVector( layer_one_node_extent ) ) );
 
-        if ( child_index_from_code != INDEX_NONE )
+        for ( MortonCode child_index = 0; child_index < 8; ++child_index )
         {
-            // Set parent->child links
-            first_child.LayerIndex = child_layer_index;
-            first_child.NodeIndex = child_index_from_code;
+            const auto tile_leaf_index = blocked_node_index * 8 + child_index;
+
+            // The leaves outside of the volume bounds stay free, and are never traversed
+            if ( !IsNodeInVolumeBounds( 0, first_child_morton_code + child_index ) )
+            {
+                continue;
+            }
+
+            if ( is_coarse )
+            {
+                tile.LeafSubNodes[ tile_leaf_index ] = ~static_cast< uint_fast64_t >( 0 );
+                tile.OccludedLeaves[ tile_leaf_index ] = true;
+                occlude_all_channels( tile_leaf_index );
+                continue;
+            }
 
-            auto & child_layer = SVOData.GetLayer( child_layer_index );
+            const auto leaf_node_position = GetLeafNodePositionFromMortonCode( first_child_morton_code + child_index );
 
-            // Set child->parent links
-            for ( auto child_index = 0; child_index < 8; ++child_index )
+            // Only the occlusion of the leaf is tested. Its sub nodes are rasterized by the first query which needs them
+            if ( rasterize_leaves_lazily )
             {
-                auto & child_node = child_layer.GetNodes()[ first_child.NodeIndex + child_index ];
+                if ( IsPositionOccluded( leaf_node_position, leaf_node_extent ) )
+                {
+                    tile.LeafSubNodes[ tile_leaf_index ] = ~static_cast< uint_fast64_t >( 0 );
+                    tile.OccludedLeaves[ tile_leaf_index ] = true;
+                    tile.UnresolvedLeaves[ tile_leaf_index ] = true;
+                    occlude_all_channels( tile_leaf_index );
+                }
 
-                child_node.Parent.LayerIndex = layer_index;
-                child_node.Parent.NodeIndex = new_node_index;
+                continue;
             }
+
+            tile.OccludedLeaves[ tile_leaf_index ] = RasterizeLeaf( leaf_node_position, tile.LeafSubNodes[ tile_leaf_index ], has_several_channels ? tile.LeafChannelSubNodes.GetData() + tile_leaf_index * channel_count : nullptr );
         }
-        else
+
+        if ( progress != nullptr )
         {
-            first_child.Invalidate();
+            progress->AddRasterizedLeaves( 8 );
         }
-    }
+    } );
 }
 
-int32 FSVOVolumeNavigationData::GetNodeIndexFromMortonCode( const LayerIndex layer_index, const MortonCode morton_code ) const
+void FSVOVolumeNavigationData::FinishGeneration( const TArray< FSVOVolumeNavigationDataTile > & tiles )
 {
-    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_GetNodeIndexFromMortonCode );
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_FinishGeneration );
 
-    const auto & layer_nodes = SVOData.GetLayer( layer_index ).GetNodes();
+    SVOData->bIsValid = false;
 
-    // Since nodes are ordered, we can use the binary search
-    return Algo::BinarySearch( layer_nodes, FSVONode( morton_code ) );
-}
+    if ( SVOData->GetLayerCount() == 0 || IsGenerationCancelled() )
+    {
+        EndGeneration();
+        return;
+    }
 
-void FSVOVolumeNavigationData::BuildNeighborLinks( const LayerIndex layer_index )
-{
-    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_BuildNeighborLinks );
+    const auto layer_count = SVOData->GetLayerCount();
+
+    // All the scratch data of the build is released at once when the mark goes out of scope
+    FMemMark mem_mark( FMemStack::Get() );
+
+    // The element N contains the nodes of the layer N + 1 which have children
+    TArray< FSVOLayerBlockedNodes, TMemStackAllocator<> > blocked_nodes;
+    blocked_nodes.SetNum( layer_count );
+
+    int64 tiles_allocated_size = 0;
+    int32 layer_one_blocked_node_count = 0;
 
-    auto & layer_nodes = SVOData.GetLayer( layer_index ).GetNodes();
-    const auto max_layer_index = GetLayerCount() - 2;
+    for ( const auto & tile : tiles )
+    {
+        tiles_allocated_size += tile.GetAllocatedSize();
+        layer_one_blocked_node_count += tile.LayerOneBlockedNodes.Num();
+    }
 
-    for ( NodeIndex layer_node_index = 0; layer_node_index < static_cast< uint32 >( layer_nodes.Num() ); layer_node_index++ )
     {
-        auto & node = layer_nodes[ layer_node_index ];
+        FSVOGenerationStageScope stage_scope( GetGenerationProgress(), ESVOGenerationStage::LayerBuild );
+
+        // The tiles are ordered by morton code, and each one covers a contiguous range of morton codes, so the blocked nodes stay sorted
+        blocked_nodes[ 0 ].Reserve( layer_one_blocked_node_count );
+
+        for ( const auto & tile : tiles )
+        {
+            blocked_nodes[ 0 ].Append( tile.LayerOneBlockedNodes );
+        }
 
-        for ( NeighborDirection direction = 0; direction < 6; direction++ )
+        for ( LayerIndex layer_index = 1; layer_index < layer_count; layer_index++ )
         {
-            NodeIndex node_index = layer_node_index;
-            FSVONodeAddress & neighbor_address = node.Neighbors[ direction ];
-            LayerIndex current_layer = layer_index;
+            const auto & child_layer_blocked_nodes = blocked_nodes[ layer_index - 1 ];
+            auto & layer_blocked_nodes = blocked_nodes[ layer_index ];
 
-            while ( !FindNeighborInDirection( neighbor_address, current_layer, node_index, direction ) && current_layer < max_layer_index )
+            // Each node has at most as many parents as there are blocked nodes in the layer below
+            layer_blocked_nodes.Reserve( child_layer_blocked_nodes.Num() );
+
+            for ( const MortonCode morton_code : child_layer_blocked_nodes )
             {
-                auto & parent_address = SVOData.GetLayer( current_layer ).GetNodes()[ node_index ].Parent;
-                if ( parent_address.IsValid() )
+                const MortonCode parent_morton_code = FSVOHelpers::GetParentMortonCode( morton_code );
+
+                // The blocked nodes are sorted, so a duplicate can only be the last added node
+                if ( layer_blocked_nodes.Num() == 0 || layer_blocked_nodes.Last() != parent_morton_code )
                 {
-                    node_index = parent_address.NodeIndex;
-                    current_layer = parent_address.LayerIndex;
+                    layer_blocked_nodes.Add( parent_morton_code );
                 }
-                else
+            }
+        }
+
+        // All the roots of the grid are created, even the free ones, so the whole volume can be traversed.
+        // They are created by groups of 8 siblings too, so the element of the top layer contains the parents they would have
+        const LayerIndex top_layer_index = layer_count - 1;
+        const auto root_counts = SVOData->GetLayerNodeCounts( top_layer_index );
+        auto & root_parents = blocked_nodes[ top_layer_index ];
+        root_parents.Reset();
+
+        for ( auto z = 0; z < root_counts.Z; ++z )
+        {
+            for ( auto y = 0; y < root_counts.Y; ++y )
+            {
+                for ( auto x = 0; x < root_counts.X; ++x )
                 {
-                    current_layer++;
-                    const auto node_index_from_morton = GetNodeIndexFromMortonCode( current_layer, FSVOHelpers::GetParentMortonCode( node.MortonCode ) );
-                    check( node_index_from_morton != INDEX_NONE );
-                    node_index = static_cast< NodeIndex >( node_index_from_morton );
+                    root_parents.Add( FSVOHelpers::GetParentMortonCode( FSVOHelpers::GetMortonCodeFromVector( FIntVector( x, y, z ) ) ) );
                 }
             }
         }
-    }
-}
 
-bool FSVOVolumeNavigationData::FindNeighborInDirection( FSVONodeAddress & node_address, const LayerIndex layer_index, const NodeIndex node_index, const NeighborDirection direction )
-{
-    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_FindNeighborInDirection );
+        root_parents.Sort();
+        root_parents.SetNum( Algo::Unique( root_parents ) );
 
-    const auto max_coordinates = static_cast< int32 >( SVOData.GetLayer( layer_index ).GetMaxNodeCount() );
-    const auto & layer_nodes = SVOData.GetLayer( layer_index ).GetNodes();
-    const auto layer_nodes_count = layer_nodes.Num();
-    const auto & target_node = layer_nodes[ node_index ];
+        RasterizeInitialLayer( tiles, blocked_nodes[ 0 ] );
 
-    FIntVector neighbor_coords( FSVOHelpers::GetVectorFromMortonCode( target_node.MortonCode ) );
-    neighbor_coords += NeighborDirections[ direction ];
+        for ( LayerIndex layer_index = 1; layer_index < layer_count; ++layer_index )
+        {
+            RasterizeLayer( layer_index, blocked_nodes[ layer_index ], blocked_nodes[ layer_index - 1 ] );
+        }
 
-    if ( neighbor_coords.X < 0 || neighbor_coords.X >= max_coordinates ||
-         neighbor_coords.Y < 0 || neighbor_coords.Y >= max_coordinates ||
-         neighbor_coords.Z < 0 || neighbor_coords.Z >= max_coordinates )
-    {
-        node_address.Invalidate();
-        return true;
+        // The last root has the biggest morton code of the grid. It needs more than 32 bits in the elongated volumes
+        checkf( GetNodeIndexFromMortonCode( top_layer_index, FSVOHelpers::GetMortonCodeFromVector( root_counts - FIntVector( 1 ) ) ) != INDEX_NONE, TEXT( "The root grid of the volume %s is incomplete" ), *VolumeBounds.ToString() );
     }
 
-    const auto neighbor_code = FSVOHelpers::GetMortonCodeFromVector( neighbor_coords );
-
-    int32 stop_index = layer_nodes_count;
-    int32 increment = 1;
-
-    if ( neighbor_code < target_node.MortonCode )
     {
-        increment = -1;
-        stop_index = -1;
+        FSVOGenerationStageScope stage_scope( GetGenerationProgress(), ESVOGenerationStage::ParentLinks );
+        BuildParentLinkForLeafNodes();
     }
 
-    for ( int32 neighbor_node_index = node_index + increment; neighbor_node_index != stop_index; neighbor_node_index += increment )
     {
-        auto & node = layer_nodes[ neighbor_node_index ];
+        FSVOGenerationStageScope stage_scope( GetGenerationProgress(), ESVOGenerationStage::NeighborLinks );
 
-        if ( node.MortonCode == neighbor_code )
+        // From the top, as the links of a layer are found from the links of its parent layer
+        for ( LayerIndex layer_index = layer_count - 1; layer_index != static_cast< LayerIndex >( -1 ); --layer_index )
         {
-            if ( layer_index == 0 &&
-                 node.HasChildren() &&
-                 SVOData.GetLeafNodes().GetLeafNode( node.FirstChild.NodeIndex ).IsCompletelyOccluded() )
-            {
-                node_address.Invalidate();
-                return true;
+            BuildNeighborLinks( layer_index );
+        }
+    }
+
+    BuildClearanceField( {} );
+
+    // The neighbor links and the clearance field are incomplete if the generation was cancelled while building them
+    SVOData->bIsValid = !IsGenerationCancelled();
+
+    int64 blocked_nodes_allocated_size = blocked_nodes.GetAllocatedSize();
+
+    for ( const auto & layer_blocked_nodes : blocked_nodes )
+    {
+        blocked_nodes_allocated_size += layer_blocked_nodes.GetAllocatedSize();
+    }
+
+    // The tiles, the blocked nodes and the new data are all alive at this point
+    const int64 peak_allocated_size = tiles_allocated_size + blocked_nodes_allocated_size + SVOData->GetAllocatedSize();
+
+    SVOData->Shrink();
+
+    if ( auto * progress = GetGenerationProgress() )
+    {
+        progress->SetMemoryUsage( peak_allocated_size, SVOData->GetAllocatedSize() );
+    }
+
+    EndGeneration();
+}
+
+void FSVOVolumeNavigationData::EndGeneration()
+{
+    if ( auto * progress = GetGenerationProgress() )
+    {
+        progress->Finish();
+    }
+
+    // The occlusion sources, the token and the progress are only needed during the generation, don't keep them alive with the data.
+    // The leaves rasterized lazily still need the occlusion sources to be resolved
+    if ( SVOData->GetLeafNodes().UnresolvedLeaves.Num() == 0 )
+    {
+        Settings.CollisionGeometrySnapshot.Reset();
+        Settings.FinestNavigationData.Reset();
+    }
+
+    Settings.ResolutionModifiers.Empty();
+    Settings.InvokerCells.Empty();
+    Settings.CancellationToken.Reset();
+    Settings.Progress.Reset();
+    TileMortonCodes.Empty();
+}
+
+void FSVOVolumeNavigationData::UpdateNavigationData( const TArray< FBox > & dirty_bounds, const FSVOVolumeNavigationDataGenerationSettings & generation_settings )
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_UpdateNavigationData );
+
+    checkf( SVOData->IsValid(), TEXT( "Only data which was already generated can be updated" ) );
+
+    // The masks of the leaves of all the channels are needed to merge the dirty leaves
+    if ( generation_settings.GenerationSettings.GetCollisionChannels() != CollisionChannels )
+    {
+        GenerateNavigationData( VolumeBounds, generation_settings );
+        return;
+    }
+
+    Settings = generation_settings;
+    InputHash = Settings.InputHash;
+
+    // The data is shared with the copies of this data, which can be queried while it is updated. It is only copied here, by the task which updates it
+    SVOData = MakeShared< FSVOData, ESPMode::ThreadSafe >( *SVOData );
+
+    // The links to the nodes of the cells which were added or removed must be built again, even if no node of layer 1 changed
+    const auto invoker_cells_changed = InvokerCells != Settings.InvokerCells;
+    InvokerCells = Settings.InvokerCells;
+
+    // Rasterize again the nodes of layer 1 touched by the dirty bounds
+    FSVOVolumeNavigationDataTile dirty_tile;
+    TArray< MortonCode > dirty_layer_one_nodes;
+    GetLayerNodesInBounds( dirty_layer_one_nodes, 1, dirty_bounds );
+
+    const auto layer_one_node_extent = SVOData->GetLayer( 1 ).GetNodeExtent();
+
+    {
+        FSVOGenerationStageScope stage_scope( GetGenerationProgress(), ESVOGenerationStage::FirstPass );
+
+        for ( const auto morton_code : dirty_layer_one_nodes )
+        {
+            if ( IsNodeInVolumeBounds( 1, morton_code ) && IsPositionOccluded( GetNodePositionFromLayerAndMortonCode( 1, morton_code ), layer_one_node_extent ) )
+            {
+                dirty_tile.LayerOneBlockedNodes.Add( morton_code );
+            }
+        }
+    }
+
+    RasterizeTileLeaves( dirty_tile );
+
+    if ( IsGenerationCancelled() )
+    {
+        SVOData->bIsValid = false;
+        EndGeneration();
+        return;
+    }
+
+    // Layer 0 contains the 8 children of each blocked node of layer 1, in morton order, and the leaf of each node of layer 0 has the same index
+    const auto & layer_zero_nodes = SVOData->GetLayer( 0 ).GetNodes();
+    const auto & leaf_nodes = SVOData->GetLeafNodes();
+
+    FSVOVolumeNavigationDataTile current_tile;
+    current_tile.LayerOneBlockedNodes.Reserve( layer_zero_nodes.Num() / 8 );
+    current_tile.LeafSubNodes.Reserve( layer_zero_nodes.Num() );
+    current_tile.OccludedLeaves.Reserve( layer_zero_nodes.Num() );
+    current_tile.UnresolvedLeaves.Reserve( layer_zero_nodes.Num() );
+    current_tile.LeafChannelSubNodes = leaf_nodes.ChannelSubNodes;
+
+    for ( auto leaf_index = 0; leaf_index < layer_zero_nodes.Num(); ++leaf_index )
+    {
+        const auto & layer_zero_node = layer_zero_nodes[ leaf_index ];
+
+        if ( leaf_index % 8 == 0 )
+        {
+            current_tile.LayerOneBlockedNodes.Add( FSVOHelpers::GetParentMortonCode( layer_zero_node.MortonCode ) );
+        }
+
+        current_tile.LeafSubNodes.Add( layer_zero_node.HasChildren() ? leaf_nodes.GetLeafNode( leaf_index ).SubNodes : 0 );
+        current_tile.OccludedLeaves.Add( layer_zero_node.HasChildren() );
+        current_tile.UnresolvedLeaves.Add( !leaf_nodes.IsLeafResolved( leaf_index ) );
+    }
+
+    // Replace the dirty nodes in the current nodes. All the lists are sorted
+    FSVOVolumeNavigationDataTile merged_tile;
+    merged_tile.LayerOneBlockedNodes.Reserve( current_tile.LayerOneBlockedNodes.Num() + dirty_tile.LayerOneBlockedNodes.Num() );
+
+    const auto channel_count = CollisionChannels.Num();
+
+    const auto append_node = [ &merged_tile, channel_count ]( const FSVOVolumeNavigationDataTile & tile, const int32 blocked_node_index ) {
+        merged_tile.LayerOneBlockedNodes.Add( tile.LayerOneBlockedNodes[ blocked_node_index ] );
+
+        if ( tile.LeafChannelSubNodes.Num() > 0 )
+        {
+            merged_tile.LeafChannelSubNodes.Append( tile.LeafChannelSubNodes.GetData() + blocked_node_index * 8 * channel_count, 8 * channel_count );
+        }
+
+        for ( auto leaf_index = blocked_node_index * 8; leaf_index < blocked_node_index * 8 + 8; ++leaf_index )
+        {
+            merged_tile.LeafSubNodes.Add( tile.LeafSubNodes[ leaf_index ] );
+            merged_tile.OccludedLeaves.Add( tile.OccludedLeaves[ leaf_index ] );
+            merged_tile.UnresolvedLeaves.Add( tile.UnresolvedLeaves.Num() > 0 && tile.UnresolvedLeaves[ leaf_index ] );
+        }
+    };
+
+    int32 dirty_tile_index = 0;
+
+    for ( auto current_tile_index = 0; current_tile_index < current_tile.LayerOneBlockedNodes.Num(); ++current_tile_index )
+    {
+        const auto morton_code = current_tile.LayerOneBlockedNodes[ current_tile_index ];
+
+        while ( dirty_tile_index < dirty_tile.LayerOneBlockedNodes.Num() && dirty_tile.LayerOneBlockedNodes[ dirty_tile_index ] < morton_code )
+        {
+            append_node( dirty_tile, dirty_tile_index++ );
+        }
+
+        if ( Algo::BinarySearch( dirty_layer_one_nodes, morton_code ) == INDEX_NONE )
+        {
+            append_node( current_tile, current_tile_index );
+        }
+    }
+
+    while ( dirty_tile_index < dirty_tile.LayerOneBlockedNodes.Num() )
+    {
+        append_node( dirty_tile, dirty_tile_index++ );
+    }
+
+    if ( invoker_cells_changed || merged_tile.LayerOneBlockedNodes != current_tile.LayerOneBlockedNodes )
+    {
+        // The structure of the octree changed, so the layers and the links must be built again. The rasterization is still limited to the dirty nodes
+        FinishGeneration( { merged_tile } );
+        return;
+    }
+
+    // Only the leaves changed. Patch them in place, and the neighbor links of the nodes of layer 0 around them, as only those can link to nodes of layer 0
+    auto & mutable_layer_zero_nodes = SVOData->GetLayer( 0 ).GetNodes();
+    auto & mutable_leaf_nodes = SVOData->GetLeafNodes();
+    TArray< NodeIndex > changed_leaf_indices;
+
+    if ( mutable_leaf_nodes.UnresolvedLeaves.Num() == 0 && merged_tile.UnresolvedLeaves.Contains( true ) )
+    {
+        mutable_leaf_nodes.UnresolvedLeaves.SetNumZeroed( merged_tile.LeafSubNodes.Num() );
+    }
+
+    for ( auto leaf_index = 0; leaf_index < merged_tile.LeafSubNodes.Num(); ++leaf_index )
+    {
+        const auto has_channel_sub_nodes = merged_tile.LeafChannelSubNodes.Num() > 0;
+        const auto channel_sub_nodes_size = channel_count * sizeof( uint_fast64_t );
+
+        if ( merged_tile.LeafSubNodes[ leaf_index ] == current_tile.LeafSubNodes[ leaf_index ]
+             && merged_tile.OccludedLeaves[ leaf_index ] == current_tile.OccludedLeaves[ leaf_index ]
+             && merged_tile.UnresolvedLeaves[ leaf_index ] == current_tile.UnresolvedLeaves[ leaf_index ]
+             && ( !has_channel_sub_nodes || FMemory::Memcmp( merged_tile.LeafChannelSubNodes.GetData() + leaf_index * channel_count, current_tile.LeafChannelSubNodes.GetData() + leaf_index * channel_count, channel_sub_nodes_size ) == 0 ) )
+        {
+            continue;
+        }
+
+        auto & layer_zero_node = mutable_layer_zero_nodes[ leaf_index ];
+
+        if ( merged_tile.OccludedLeaves[ leaf_index ] )
+        {
+            layer_zero_node.FirstChild.LayerIndex = 0;
+            layer_zero_node.FirstChild.NodeIndex = leaf_index;
+            layer_zero_node.FirstChild.SubNodeIndex = 0;
+        }
+        else
+        {
+            layer_zero_node.FirstChild.Invalidate();
+        }
+
+        mutable_leaf_nodes.GetLeafNode( leaf_index ).SubNodes = merged_tile.LeafSubNodes[ leaf_index ];
+
+        if ( has_channel_sub_nodes )
+        {
+            FMemory::Memcpy( mutable_leaf_nodes.ChannelSubNodes.GetData() + leaf_index * channel_count, merged_tile.LeafChannelSubNodes.GetData() + leaf_index * channel_count, channel_sub_nodes_size );
+        }
+
+        if ( mutable_leaf_nodes.UnresolvedLeaves.Num() > 0 )
+        {
+            mutable_leaf_nodes.UnresolvedLeaves[ leaf_index ] = merged_tile.UnresolvedLeaves[ leaf_index ];
+        }
+
+        changed_leaf_indices.Add( leaf_index );
+    }
+
+    TSet< NodeIndex > nodes_to_link;
+
+    for ( const auto leaf_index : changed_leaf_indices )
+    {
+        nodes_to_link.Add( leaf_index );
+
+        const FIntVector node_coords( FSVOHelpers::GetVectorFromMortonCode( mutable_layer_zero_nodes[ leaf_index ].MortonCode ) );
+
+        for ( const auto & neighbor_direction : NeighborDirections )
+        {
+            const auto neighbor_coords = node_coords + neighbor_direction;
+
+            if ( neighbor_coords.GetMin() < 0 )
+            {
+                continue;
+            }
+
+            const auto neighbor_node_index = GetNodeIndexFromMortonCode( 0, FSVOHelpers::GetMortonCodeFromVector( neighbor_coords ) );
+
+            if ( neighbor_node_index != INDEX_NONE )
+            {
+                nodes_to_link.Add( static_cast< NodeIndex >( neighbor_node_index ) );
+            }
+        }
+    }
+
+    {
+        FSVOGenerationStageScope stage_scope( GetGenerationProgress(), ESVOGenerationStage::NeighborLinks );
+
+        for ( const auto node_index : nodes_to_link )
+        {
+            BuildNodeNeighborLinks( 0, node_index );
+        }
+    }
+
+    // Only the nodes within the maximum clearance of the changed leaves can have a different clearance
+    BuildClearanceField( dirty_bounds );
+    SVOData->bIsValid = !IsGenerationCancelled();
+
+    EndGeneration();
+}
+
+void FSVOVolumeNavigationData::GetLayerNodesInBounds( TArray< MortonCode > & morton_codes, const LayerIndex layer_index, const TArray< FBox > & bounds ) const
+{
+    const auto & navigation_bounds = SVOData->GetNavigationBounds();
+    const auto layer_node_size = SVOData->GetLayer( layer_index ).GetNodeSize();
+    const auto layer_max_coordinates = SVOData->GetLayerNodeCounts( layer_index ) - FIntVector( 1 );
+
+    for ( const auto & box : bounds )
+    {
+        // The nodes are tested with an extent increased by the clearance, so the nodes a bit further away can be affected too.
+        // Nothing is rasterized outside of the volume bounds
+        const auto clipped_box = VolumeBounds.Overlap( box.ExpandBy( Settings.GenerationSettings.Clearance ) );
+
+        if ( !clipped_box.IsValid )
+        {
+            continue;
+        }
+
+        const auto get_coordinates = [ & ]( const FVector & position ) {
+            const auto local_position = ( position - navigation_bounds.Min ) / layer_node_size;
+            return FIntVector(
+                FMath::Clamp( FMath::FloorToInt( local_position.X ), 0, layer_max_coordinates.X ),
+                FMath::Clamp( FMath::FloorToInt( local_position.Y ), 0, layer_max_coordinates.Y ),
+                FMath::Clamp( FMath::FloorToInt( local_position.Z ), 0, layer_max_coordinates.Z ) );
+        };
+
+        const auto min_coordinates = get_coordinates( clipped_box.Min );
+        const auto max_coordinates = get_coordinates( clipped_box.Max );
+
+        for ( auto z = min_coordinates.Z; z <= max_coordinates.Z; ++z )
+        {
+            for ( auto y = min_coordinates.Y; y <= max_coordinates.Y; ++y )
+            {
+                for ( auto x = min_coordinates.X; x <= max_coordinates.X; ++x )
+                {
+                    morton_codes.Add( FSVOHelpers::GetMortonCodeFromVector( FIntVector( x, y, z ) ) );
+                }
+            }
+        }
+    }
+
+    morton_codes.Sort();
+    morton_codes.SetNum( Algo::Unique( morton_codes ) );
+}
+
+void FSVOVolumeNavigationData::Serialize( FArchive & archive, const ESVOVersion version )
+{
+    // The occlusion sources are not saved, so the leaves can't be resolved once loaded
+    if ( archive.IsSaving() )
+    {
+        ResolveAllLeaves();
+    }
+
+    // when writing, write a zero here for now.  will come back and fill it in later.
+    auto svo_size_bytes = 0;
+    const auto svo_size_position = archive.Tell();
+
+    archive << svo_size_bytes;
+
+    if ( archive.IsLoading() )
+    {
+        if ( version < ESVOVersion::MinCompatible )
+        {
+            // incompatible, just skip over this data
+            archive.Seek( svo_size_position + svo_size_bytes );
+            return;
+        }
+    }
+
+    if ( archive.IsLoading() )
+    {
+        SVOData = MakeShared< FSVOData, ESPMode::ThreadSafe >();
+    }
+
+    archive << VolumeBounds;
+    archive << *SVOData;
+    archive << VolumeNavigationQueryFilter;
+    archive << bInNavigationDataChunk;
+
+    if ( version >= ESVOVersion::InputHash )
+    {
+        archive << InputHash;
+    }
+    else
+    {
+        InputHash = 0;
+    }
+
+    if ( version >= ESVOVersion::ClearanceField )
+    {
+        for ( auto & layer : SVOData->Layers )
+        {
+            archive << layer.NodeClearances;
+        }
+
+        archive << SVOData->GetLeafNodes().SubNodeClearances;
+    }
+
+    if ( version >= ESVOVersion::InvokerCells )
+    {
+        archive << InvokerCells;
+    }
+    else
+    {
+        InvokerCells.Reset();
+    }
+
+    if ( version >= ESVOVersion::CollisionChannels )
+    {
+        archive << CollisionChannels;
+        archive << SVOData->GetLeafNodes().ChannelSubNodes;
+    }
+    else
+    {
+        CollisionChannels.Reset();
+        SVOData->GetLeafNodes().ChannelSubNodes.Reset();
+    }
+
+    if ( archive.IsSaving() )
+    {
+        const auto current_position = archive.Tell();
+
+        svo_size_bytes = current_position - svo_size_position;
+
+        archive.Seek( svo_size_position );
+        archive << svo_size_bytes;
+        archive.Seek( current_position );
+    }
+}
+
+uint64 FSVOVolumeNavigationData::ComputeInputHash( const UWorld & world, const FBox & volume_bounds, const FSVOVolumeNavigationDataGenerationSettings & generation_settings )
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_ComputeInputHash );
+
+    uint64 hash = 0;
+
+    const auto hash_bytes = [ &hash ]( const void * data, const uint32 size ) {
+        hash = CityHash64WithSeed( static_cast< const char * >( data ), size, hash );
+    };
+
+    const auto hash_vector = [ &hash_bytes ]( const FVector & vector ) {
+        const double components[ 3 ] = { vector.X, vector.Y, vector.Z };
+        hash_bytes( components, sizeof( components ) );
+    };
+
+    const auto & settings = generation_settings.GenerationSettings;
+    const auto version = static_cast< uint8 >( ESVOVersion::Latest );
+    const auto collision_channel = static_cast< uint8 >( settings.CollisionChannel.GetValue() );
+    const auto occlusion_source = static_cast< uint8 >( settings.OcclusionSource );
+    const uint8 generate_clearance_field = settings.bGenerateClearanceField;
+    const auto resolution = static_cast< uint8 >( settings.Resolution );
+
+    hash_bytes( &version, sizeof( version ) );
+    hash_bytes( &collision_channel, sizeof( collision_channel ) );
+    hash_bytes( &occlusion_source, sizeof( occlusion_source ) );
+    hash_bytes( &generate_clearance_field, sizeof( generate_clearance_field ) );
+    hash_bytes( &resolution, sizeof( resolution ) );
+    hash_bytes( &settings.Clearance, sizeof( settings.Clearance ) );
+    hash_bytes( &generation_settings.VoxelExtent, sizeof( generation_settings.VoxelExtent ) );
+    hash_vector( volume_bounds.Min );
+    hash_vector( volume_bounds.Max );
+
+    for ( const auto channel : settings.GetCollisionChannels() )
+    {
+        const auto channel_value = static_cast< uint8 >( channel.GetValue() );
+        hash_bytes( &channel_value, sizeof( channel_value ) );
+    }
+
+    // The invoker cells are sorted by the generator
+    for ( const auto & invoker_cell : generation_settings.InvokerCells )
+    {
+        hash_vector( invoker_cell.Min );
+        hash_vector( invoker_cell.Max );
+    }
+
+    const auto settings_hash = hash;
+    const auto collision_channels = settings.GetCollisionChannels();
+
+    // Same bounds as the snapshot of a whole volume
+    const auto gather_bounds = FSVOData::ComputeNavigationBounds( generation_settings.VoxelExtent, volume_bounds ).ExpandBy( settings.Clearance );
+
+    TArray< const UPrimitiveComponent * > primitive_components;
+    FSVOCollisionGeometrySnapshot::GatherPrimitiveComponents( primitive_components, world, gather_bounds, settings );
+
+    TArray< uint64 > primitive_hashes;
+    primitive_hashes.Reserve( primitive_components.Num() );
+
+    for ( const auto * primitive_component : primitive_components )
+    {
+        hash = 0;
+
+        const auto & transform = primitive_component->GetComponentTransform();
+        const auto rotation = transform.GetRotation();
+        const double rotation_components[ 4 ] = { rotation.X, rotation.Y, rotation.Z, rotation.W };
+        const auto bounds = primitive_component->Bounds.GetBox();
+
+        hash_vector( transform.GetLocation() );
+        hash_bytes( rotation_components, sizeof( rotation_components ) );
+        hash_vector( transform.GetScale3D() );
+        hash_vector( bounds.Min );
+        hash_vector( bounds.Max );
+
+        // The primitive occludes each channel it does not ignore
+        for ( const auto collision_channel : collision_channels )
+        {
+            const auto collision_response = static_cast< uint8 >( primitive_component->GetCollisionResponseToChannel( collision_channel ) );
+            hash_bytes( &collision_response, sizeof( collision_response ) );
+        }
+
+        // The guid of the body setup changes with its collision geometry
+        if ( const auto * body_setup = const_cast< UPrimitiveComponent * >( primitive_component )->GetBodySetup() )
+        {
+            const auto collision_trace_flag = static_cast< uint8 >( body_setup->CollisionTraceFlag.GetValue() );
+
+            hash_bytes( &body_setup->BodySetupGuid, sizeof( body_setup->BodySetupGuid ) );
+            hash_bytes( &collision_trace_flag, sizeof( collision_trace_flag ) );
+        }
+
+        primitive_hashes.Add( hash );
+    }
+
+    // The resolution modifiers are hashed like the primitives, as their order is not deterministic either
+    for ( const auto & resolution_modifier : generation_settings.ResolutionModifiers )
+    {
+        hash = 0;
+
+        const auto modifier_resolution = static_cast< uint8 >( resolution_modifier.Resolution );
+
+        hash_vector( resolution_modifier.Bounds.Min );
+        hash_vector( resolution_modifier.Bounds.Max );
+        hash_bytes( &modifier_resolution, sizeof( modifier_resolution ) );
+
+        primitive_hashes.Add( hash );
+    }
+
+    // The order of the actors in the levels is not deterministic
+    primitive_hashes.Sort();
+
+    return CityHash64WithSeed( reinterpret_cast< const char * >( primitive_hashes.GetData() ), primitive_hashes.Num() * sizeof( uint64 ), settings_hash );
+}
+
+void FSVOVolumeNavigationData::Reset()
+{
+    VolumeBounds.Init();
+    InvokerCells.Reset();
+    CollisionChannels.Reset();
+    SVOData = MakeShared< FSVOData, ESPMode::ThreadSafe >();
+}
+
+bool FSVOVolumeNavigationData::IsPositionOccluded( const FVector & position, const float box_extent ) const
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_IsPositionOccluded );
+
+    if ( Settings.CollisionGeometrySnapshot.IsValid() )
+    {
+        return Settings.CollisionGeometrySnapshot->IsBoxOccluded( FBox::BuildAABB( position, FVector( box_extent + Settings.GenerationSettings.Clearance ) ) );
+    }
+
+    if ( Settings.FinestNavigationData.IsValid() )
+    {
+        // The occluded sub nodes of the finest data are already dilated by its own clearance, which must not be added twice.
+        // Any geometry in the box is then in, or close enough to, an occluded sub node overlapping the box
+        const auto finest_clearance = Settings.FinestNavigationData->GetDataGenerationSettings().GenerationSettings.Clearance;
+        const auto clearance = Settings.GenerationSettings.Clearance - FMath::Min( finest_clearance, Settings.GenerationSettings.Clearance );
+
+        return Settings.FinestNavigationData->IsBoxOccluded( FBox::BuildAABB( position, FVector( box_extent + clearance ) ) );
+    }
+
+    const auto * world = Settings.World.Get();
+
+    // Nothing can be tested anymore once the world is torn down, so the space is considered occluded
+    if ( world == nullptr )
+    {
+        return true;
+    }
+
+    // The octree is built from the union of the channels
+    if ( CollisionChannels.Num() > 1 )
+    {
+        return GetOccludedChannels( position, box_extent ) != 0;
+    }
+
+    TArray< FOverlapResult > overlap_results;
+    const auto result = world->OverlapMultiByChannel(
+        overlap_results,
+        position,
+        FQuat::Identity,
+        Settings.GenerationSettings.CollisionChannel,
+        FCollisionShape::MakeBox( FVector( box_extent + Settings.GenerationSettings.Clearance ) ),
+        Settings.GenerationSettings.CollisionQueryParameters );
+
+    if ( !result )
+    {
+        return false;
+    }
+
+    return overlap_results.FindByPredicate( []( const FOverlapResult & overlap_result ) {
+        return overlap_result.GetComponent()->CanEverAffectNavigation();
+    } ) != nullptr;
+}
+
+uint32 FSVOVolumeNavigationData::GetOccludedChannels( const FVector & position, const float box_extent ) const
+{
+    if ( CollisionChannels.Num() <= 1 )
+    {
+        return IsPositionOccluded( position, box_extent ) ? 1 : 0;
+    }
+
+    if ( !Settings.World.IsValid() )
+    {
+        return ( 1u << CollisionChannels.Num() ) - 1;
+    }
+
+    TArray< const UPrimitiveComponent * > primitive_components;
+    TArray< uint32 > primitive_channels;
+    GatherOccludingPrimitiveComponents( primitive_components, primitive_channels, position, box_extent );
+
+    uint32 occluded_channels = 0;
+
+    for ( const auto channels : primitive_channels )
+    {
+        occluded_channels |= channels;
+    }
+
+    return occluded_channels;
+}
+
+void FSVOVolumeNavigationData::GatherOccludingPrimitiveComponents( TArray< const UPrimitiveComponent * > & primitive_components, TArray< uint32 > & primitive_channels, const FVector & position, const float box_extent ) const
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_GatherOccludingPrimitiveComponents );
+
+    const auto * world = Settings.World.Get();
+
+    if ( world == nullptr )
+    {
+        return;
+    }
+
+    const auto collision_shape = FCollisionShape::MakeBox( FVector( box_extent + Settings.GenerationSettings.Clearance ) );
+    const auto has_several_channels = CollisionChannels.Num() > 1;
+    TArray< FOverlapResult > overlap_results;
+
+    if ( has_several_channels )
+    {
+        static const auto AllObjectTypesQueryParams = MakeAllObjectTypesQueryParams();
+
+        // A single query returns the primitives of all the object types, which are then classified by their responses to each channel
+        world->OverlapMultiByObjectType(
+            overlap_results,
+            position,
+            FQuat::Identity,
+            AllObjectTypesQueryParams,
+            collision_shape,
+            Settings.GenerationSettings.CollisionQueryParameters );
+    }
+    else
+    {
+        world->OverlapMultiByChannel(
+            overlap_results,
+            position,
+            FQuat::Identity,
+            Settings.GenerationSettings.CollisionChannel,
+            collision_shape,
+            Settings.GenerationSettings.CollisionQueryParameters );
+    }
+
+    // A primitive is returned once per overlapping body
+    TSet< const UPrimitiveComponent * > visited_primitive_components;
+    visited_primitive_components.Reserve( overlap_results.Num() );
+
+    for ( const auto & overlap_result : overlap_results )
+    {
+        const auto * primitive_component = overlap_result.GetComponent();
+
+        if ( primitive_component == nullptr || !primitive_component->CanEverAffectNavigation() )
+        {
+            continue;
+        }
+
+        bool is_already_visited;
+        visited_primitive_components.Add( primitive_component, &is_already_visited );
+
+        if ( is_already_visited )
+        {
+            continue;
+        }
+
+        uint32 channels = 1;
+
+        if ( has_several_channels )
+        {
+            channels = 0;
+
+            for ( auto channel_index = 0; channel_index < CollisionChannels.Num(); ++channel_index )
+            {
+                if ( primitive_component->GetCollisionResponseToChannel( CollisionChannels[ channel_index ] ) != ECR_Ignore )
+                {
+                    channels |= 1U << channel_index;
+                }
+            }
+        }
+
+        if ( channels != 0 )
+        {
+            primitive_components.Add( primitive_component );
+            primitive_channels.Add( channels );
+        }
+    }
+}
+
+bool FSVOVolumeNavigationData::IsNodeInVolumeBounds( const LayerIndex layer_index, const MortonCode morton_code ) const
+{
+    const FIntVector node_coords( FSVOHelpers::GetVectorFromMortonCode( morton_code ) );
+    const auto layer_node_counts = SVOData->GetLayerNodeCounts( layer_index );
+
+    // The top layer contains the siblings of the roots, which can be outside of the grid
+    if ( node_coords.X >= layer_node_counts.X || node_coords.Y >= layer_node_counts.Y || node_coords.Z >= layer_node_counts.Z )
+    {
+        return false;
+    }
+
+    const auto node_bounds = FBox::BuildAABB( GetNodePositionFromLayerAndMortonCode( layer_index, morton_code ), FVector( SVOData->GetLayer( layer_index ).GetNodeExtent() ) );
+
+    if ( !DoBoxesOverlap( node_bounds, VolumeBounds ) )
+    {
+        return false;
+    }
+
+    return InvokerCells.Num() == 0 || InvokerCells.ContainsByPredicate( [ &node_bounds ]( const FBox & invoker_cell ) {
+        return DoBoxesOverlap( node_bounds, invoker_cell );
+    } );
+}
+
+bool FSVOVolumeNavigationData::IsBoxInInvokerCells( const FBox & box ) const
+{
+    if ( InvokerCells.Num() == 0 )
+    {
+        return true;
+    }
+
+    // The cells are the cubes of a grid aligned on the world origin, so the box is covered if the center of each cube of the grid it overlaps is in a cell
+    const auto invoker_cell_size = InvokerCells[ 0 ].GetSize().X;
+    const FIntVector min_coords(
+        FMath::FloorToInt( box.Min.X / invoker_cell_size ),
+        FMath::FloorToInt( box.Min.Y / invoker_cell_size ),
+        FMath::FloorToInt( box.Min.Z / invoker_cell_size ) );
+    const FIntVector max_coords(
+        FMath::CeilToInt( box.Max.X / invoker_cell_size ) - 1,
+        FMath::CeilToInt( box.Max.Y / invoker_cell_size ) - 1,
+        FMath::CeilToInt( box.Max.Z / invoker_cell_size ) - 1 );
+
+    for ( auto z = min_coords.Z; z <= max_coords.Z; ++z )
+    {
+        for ( auto y = min_coords.Y; y <= max_coords.Y; ++y )
+        {
+            for ( auto x = min_coords.X; x <= max_coords.X; ++x )
+            {
+                const auto cell_center = ( FVector( x, y, z ) + 0.5f ) * invoker_cell_size;
+
+                if ( !InvokerCells.ContainsByPredicate( [ &cell_center ]( const FBox & invoker_cell ) {
+                         return invoker_cell.IsInside( cell_center );
+                     } ) )
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+void FSVOVolumeNavigationData::HierarchicalRasterization( TArray< MortonCode > & layer_one_blocked_nodes, const LayerIndex layer_index, const MortonCode morton_code ) const
+{
+    const auto & layer = SVOData->GetLayer( layer_index );
+    const auto position = GetNodePositionFromLayerAndMortonCode( layer_index, morton_code );
+
+    if ( IsGenerationCancelled() )
+    {
+        return;
+    }
+
+    // The nodes outside of the volume bounds stay free, and are never traversed
+    if ( !IsNodeInVolumeBounds( layer_index, morton_code ) )
+    {
+        return;
+    }
+
+    // If the node is free, all its children are free too
+    if ( !IsPositionOccluded( position, layer.GetNodeExtent() ) )
+    {
+        return;
+    }
+
+    if ( layer_index == 1 )
+    {
+        // Children are visited in morton order, so the blocked nodes are added sorted, as with the exhaustive pass
+        layer_one_blocked_nodes.Add( morton_code );
+        return;
+    }
+
+    const auto first_child_morton_code = FSVOHelpers::GetFirstChildMortonCode( morton_code );
+
+    for ( MortonCode child_index = 0; child_index < 8; ++child_index )
+    {
+        HierarchicalRasterization( layer_one_blocked_nodes, layer_index - 1, first_child_morton_code + child_index );
+    }
+}
+
+bool FSVOVolumeNavigationData::RasterizeLeaf( const FVector & node_position, uint_fast64_t & sub_nodes, uint_fast64_t * channel_sub_nodes ) const
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_RasterizeLeaf );
+
+    const auto & leaf_nodes = SVOData->GetLeafNodes();
+    const auto leaf_node_extent = leaf_nodes.GetLeafNodeExtent();
+    const auto leaf_sub_node_size = leaf_nodes.GetLeafSubNodeSize();
+    const auto leaf_sub_node_extent = leaf_nodes.GetLeafSubNodeExtent();
+    const auto location = node_position - leaf_node_extent;
+    const auto channel_count = CollisionChannels.Num();
+    const auto all_channels = static_cast< uint32 >( ( 1ULL << channel_count ) - 1 );
+
+    // When gathering the primitives per leaf, the overlap query of the leaf returns all the primitives which can occlude its sub nodes,
+    // which are then only tested against those primitives instead of the whole scene
+    const auto gather_primitives_per_leaf = Settings.GenerationSettings.bGatherPrimitivesPerLeaf && !Settings.CollisionGeometrySnapshot.IsValid() && !Settings.FinestNavigationData.IsValid();
+    TArray< const UPrimitiveComponent * > leaf_primitive_components;
+    TArray< uint32 > leaf_primitive_channels;
+
+    if ( gather_primitives_per_leaf )
+    {
+        GatherOccludingPrimitiveComponents( leaf_primitive_components, leaf_primitive_channels, node_position, leaf_node_extent );
+
+        if ( leaf_primitive_components.Num() == 0 )
+        {
+            return false;
+        }
+    }
+    else if ( !IsPositionOccluded( node_position, leaf_node_extent ) )
+    {
+        return false;
+    }
+
+    // Returns the channels occluded in the box. The primitives are tested until all the channels are occluded, so a single one is enough with a single channel
+    const auto get_occluded_channels = [ & ]( const FVector & position, const float box_extent ) {
+        if ( !gather_primitives_per_leaf )
+        {
+            return GetOccludedChannels( position, box_extent );
+        }
+
+        const auto collision_shape = FCollisionShape::MakeBox( FVector( box_extent + Settings.GenerationSettings.Clearance ) );
+        uint32 occluded_channels = 0;
+
+        for ( auto primitive_index = 0; primitive_index < leaf_primitive_components.Num() && occluded_channels != all_channels; ++primitive_index )
+        {
+            if ( ( leaf_primitive_channels[ primitive_index ] & ~occluded_channels ) != 0 && leaf_primitive_components[ primitive_index ]->OverlapComponent( position, FQuat::Identity, collision_shape ) )
+            {
+                occluded_channels |= leaf_primitive_channels[ primitive_index ];
             }
+        }
+
+        return occluded_channels;
+    };
+
+    // Build the masks locally, and write them once in the result
+    uint_fast64_t leaf_sub_nodes = 0;
+    uint_fast64_t leaf_channel_sub_nodes[ FSVODataGenerationSettings::MaxCollisionChannelCount ] = {};
+
+    const auto rasterize_sub_node = [ & ]( const SubNodeIndex sub_node_index ) {
+        const auto morton_coords = FSVOHelpers::GetVectorFromMortonCode( sub_node_index );
+        const auto leaf_node_location = location + morton_coords * leaf_sub_node_size + leaf_sub_node_extent;
+        const auto occluded_channels = get_occluded_channels( leaf_node_location, leaf_sub_node_extent );
+
+        if ( occluded_channels == 0 )
+        {
+            return;
+        }
+
+        leaf_sub_nodes |= 1ULL << sub_node_index;
+
+        for ( auto channel_index = 0; channel_index < channel_count; ++channel_index )
+        {
+            if ( ( occluded_channels & ( 1U << channel_index ) ) != 0 )
+            {
+                leaf_channel_sub_nodes[ channel_index ] |= 1ULL << sub_node_index;
+            }
+        }
+    };
+
+    if ( !Settings.GenerationSettings.bUseHierarchicalRasterization )
+    {
+        for ( SubNodeIndex sub_node_index = 0; sub_node_index < 64; sub_node_index++ )
+        {
+            rasterize_sub_node( sub_node_index );
+        }
+    }
+    else
+    {
+        // Test the 8 octants of the leaf first (each one is 2x2x2 sub nodes), and only test the sub nodes of the occluded octants.
+        // The sub node index is ( octant_index << 3 ) + child_index, as explained in USVORayCaster_OctreeTraversal
+        for ( SubNodeIndex octant_index = 0; octant_index < 8; octant_index++ )
+        {
+            const auto octant_morton_coords = FSVOHelpers::GetVectorFromMortonCode( octant_index );
+            const auto octant_location = location + octant_morton_coords * leaf_node_extent + leaf_sub_node_size;
 
-            node_address.LayerIndex = layer_index;
+            if ( get_occluded_channels( octant_location, leaf_sub_node_size ) == 0 )
+            {
+                continue;
+            }
 
-            if ( neighbor_node_index >= layer_nodes_count || neighbor_node_index < 0 )
+            for ( SubNodeIndex child_index = 0; child_index < 8; child_index++ )
             {
-                break;
+                rasterize_sub_node( ( octant_index << 3 ) + child_index );
             }
+        }
+    }
 
-            node_address.NodeIndex = neighbor_node_index;
+    sub_nodes = leaf_sub_nodes;
 
-            return true;
+    if ( channel_sub_nodes != nullptr )
+    {
+        FMemory::Memcpy( channel_sub_nodes, leaf_channel_sub_nodes, channel_count * sizeof( uint_fast64_t ) );
+    }
+
+    return true;
+}
+
+void FSVOVolumeNavigationData::ResolveLeaf( const LeafIndex leaf_index ) const
+{
+    SCOPE_CYCLE_COUNTER( STAT_SVONavigation_ResolveLeaf );
+    INC_DWORD_STAT( STAT_SVONavigation_ResolvedLeafCount );
+
+    // The leaf stays completely occluded if the world it was generated in is gone
+    uint_fast64_t sub_nodes = ~static_cast< uint_fast64_t >( 0 );
+    uint_fast64_t channel_sub_nodes[ FSVODataGenerationSettings::MaxCollisionChannelCount ];
+    FMemory::Memset( channel_sub_nodes, 0xFF, sizeof( channel_sub_nodes ) );
+
+    const auto channel_count = CollisionChannels.Num();
+    auto * channel_sub_nodes_pointer = channel_count > 1 ? channel_sub_nodes : nullptr;
+
+    if ( Settings.World.IsValid() || Settings.CollisionGeometrySnapshot.IsValid() || Settings.FinestNavigationData.IsValid() )
+    {
+        const auto leaf_node_position = GetLeafNodePositionFromMortonCode( SVOData->GetLayer( 0 ).GetNode( leaf_index ).MortonCode );
+
+        if ( !RasterizeLeaf( leaf_node_position, sub_nodes, channel_sub_nodes_pointer ) )
+        {
+            sub_nodes = 0;
+            FMemory::Memzero( channel_sub_nodes, sizeof( channel_sub_nodes ) );
+        }
+    }
+
+    SVOData->GetLeafNodes().ResolveLeaf( leaf_index, sub_nodes, channel_sub_nodes_pointer, channel_count );
+}
+
+void FSVOVolumeNavigationData::ResolveAllLeaves() const
+{
+    const auto & leaf_nodes = SVOData->GetLeafNodes();
+
+    if ( leaf_nodes.UnresolvedLeaves.Num() == 0 )
+    {
+        return;
+    }
+
+    ParallelFor( leaf_nodes.GetLeafNodes().Num(), [ & ]( const int32 leaf_index ) {
+        GetLeafNode( leaf_index );
+    } );
+}
+
+bool FSVOVolumeNavigationData::IsCoarseResolution( const FBox & node_bounds ) const
+{
+    auto resolution = Settings.GenerationSettings.Resolution;
+
+    // Full resolution wins where the modifiers overlap, so the details are kept wherever they are requested
+    for ( const auto & resolution_modifier : Settings.ResolutionModifiers )
+    {
+        if ( !DoBoxesOverlap( resolution_modifier.Bounds, node_bounds ) )
+        {
+            continue;
         }
 
-        // If we've passed the code we're looking for, it's not on this layer
-        if ( increment == -1 && node.MortonCode < neighbor_code || increment == 1 && node.MortonCode > neighbor_code )
+        if ( resolution_modifier.Resolution == ESVOResolution::Full )
         {
             return false;
         }
+
+        resolution = ESVOResolution::Coarse;
     }
-    return false;
+
+    return resolution == ESVOResolution::Coarse;
+}
+
+void FSVOVolumeNavigationData::RasterizeInitialLayer( const TArray< FSVOVolumeNavigationDataTile > & tiles, const FSVOLayerBlockedNodes & layer_one_blocked_nodes )
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_RasterizeInitialLayer );
+
+    auto & layer_zero_nodes = SVOData->GetLayer( 0 ).GetNodes();
+    layer_zero_nodes.Reset( layer_one_blocked_nodes.Num() * 8 );
+
+    // First create all the nodes of the layer. The blocked nodes are sorted, so the children of each blocked node are emitted in morton order
+    for ( const MortonCode parent_morton_code : layer_one_blocked_nodes )
+    {
+        const auto first_child_morton_code = FSVOHelpers::GetFirstChildMortonCode( parent_morton_code );
+
+        for ( MortonCode child_index = 0; child_index < 8; ++child_index )
+        {
+            layer_zero_nodes.Emplace( first_child_morton_code + child_index );
+        }
+    }
+
+    auto & leaf_nodes = SVOData->GetLeafNodes();
+    leaf_nodes.AllocateLeafNodes( layer_zero_nodes.Num() );
+
+    if ( tiles.ContainsByPredicate( []( const FSVOVolumeNavigationDataTile & tile ) {
+             return tile.UnresolvedLeaves.Contains( true );
+         } ) )
+    {
+        leaf_nodes.UnresolvedLeaves.SetNumZeroed( layer_zero_nodes.Num() );
+    }
+
+    const auto channel_count = CollisionChannels.Num();
+
+    if ( channel_count > 1 )
+    {
+        leaf_nodes.ChannelSubNodes.SetNumZeroed( layer_zero_nodes.Num() * channel_count );
+    }
+
+    // The leaves of the tiles are in the same order as the nodes created above
+    LeafIndex leaf_index = 0;
+
+    for ( const auto & tile : tiles )
+    {
+        for ( auto tile_leaf_index = 0; tile_leaf_index < tile.LeafSubNodes.Num(); ++tile_leaf_index, ++leaf_index )
+        {
+            auto & layer_zero_node = layer_zero_nodes[ leaf_index ];
+
+            if ( tile.OccludedLeaves[ tile_leaf_index ] )
+            {
+                leaf_nodes.GetLeafNode( leaf_index ).SubNodes = tile.LeafSubNodes[ tile_leaf_index ];
+
+                if ( leaf_nodes.UnresolvedLeaves.Num() > 0 )
+                {
+                    leaf_nodes.UnresolvedLeaves[ leaf_index ] = tile.UnresolvedLeaves.Num() > 0 && tile.UnresolvedLeaves[ tile_leaf_index ];
+                }
+
+                if ( tile.LeafChannelSubNodes.Num() > 0 )
+                {
+                    FMemory::Memcpy( leaf_nodes.ChannelSubNodes.GetData() + leaf_index * channel_count, tile.LeafChannelSubNodes.GetData() + tile_leaf_index * channel_count, channel_count * sizeof( uint_fast64_t ) );
+                }
+
+                layer_zero_node.FirstChild.LayerIndex = 0;
+                layer_zero_node.FirstChild.NodeIndex = leaf_index;
+                layer_zero_node.FirstChild.SubNodeIndex = 0;
+            }
+            else
+            {
+                layer_zero_node.FirstChild.Invalidate();
+            }
+        }
+    }
+}
+
+void FSVOVolumeNavigationData::RasterizeLayer( const LayerIndex layer_index, const FSVOLayerBlockedNodes & layer_blocked_nodes, const FSVOLayerBlockedNodes & child_layer_blocked_nodes )
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_RasterizeLayer );
+
+    checkf( layer_index > 0 && layer_index < GetLayerCount(), TEXT( "layer_index is out of bounds" ) );
+
+    auto & layer_nodes = SVOData->GetLayer( layer_index ).GetNodes();
+
+    const LayerIndex child_layer_index = layer_index - 1;
+    auto & child_layer_nodes = SVOData->GetLayer( child_layer_index ).GetNodes();
+    // child_layer_blocked_nodes are the nodes of this layer which have children. The children of the N-th of those nodes are at the index N * 8 in the child layer
+    const auto child_layer_blocked_node_count = child_layer_blocked_nodes.Num();
+    int32 child_layer_blocked_node_index = 0;
+
+    layer_nodes.Reset( layer_blocked_nodes.Num() * 8 );
+
+    for ( const MortonCode parent_morton_code : layer_blocked_nodes )
+    {
+        const auto first_morton_code = FSVOHelpers::GetFirstChildMortonCode( parent_morton_code );
+
+        for ( MortonCode child_index = 0; child_index < 8; ++child_index )
+        {
+            const NodeIndex new_node_index = layer_nodes.Emplace( first_morton_code + child_index );
+            auto & layer_node = layer_nodes[ new_node_index ];
+
+            // Both lists are sorted, so we just need to walk the blocked nodes of the child layer alongside the nodes we create
+            while ( child_layer_blocked_node_index < child_layer_blocked_node_count && child_layer_blocked_nodes[ child_layer_blocked_node_index ] < layer_node.MortonCode )
+            {
+                ++child_layer_blocked_node_index;
+            }
+
+            auto & first_child = layer_node.FirstChild;
+
+            if ( child_layer_blocked_node_index < child_layer_blocked_node_count && child_layer_blocked_nodes[ child_layer_blocked_node_index ] == layer_node.MortonCode )
+            {
+                // Set parent->child links
+                first_child.LayerIndex = child_layer_index;
+                first_child.NodeIndex = child_layer_blocked_node_index * 8;
+
+                // Set child->parent links
+                for ( auto child_node_index = 0; child_node_index < 8; ++child_node_index )
+                {
+                    auto & child_node = child_layer_nodes[ first_child.NodeIndex + child_node_index ];
+
+                    child_node.Parent.LayerIndex = layer_index;
+                    child_node.Parent.NodeIndex = new_node_index;
+                }
+            }
+            else
+            {
+                first_child.Invalidate();
+            }
+        }
+    }
+}
+
+int32 FSVOVolumeNavigationData::GetNodeIndexFromMortonCode( const LayerIndex layer_index, const MortonCode morton_code ) const
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_GetNodeIndexFromMortonCode );
+
+    const auto & layer_nodes = SVOData->GetLayer( layer_index ).GetNodes();
+
+    // Since nodes are ordered, we can use the binary search
+    return Algo::BinarySearch( layer_nodes, FSVONode( morton_code ) );
+}
+
+void FSVOVolumeNavigationData::BuildClearanceField( const TArray< FBox > & dirty_bounds )
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_BuildClearanceField );
+
+    auto & leaf_nodes = SVOData->GetLeafNodes();
+
+    if ( !Settings.GenerationSettings.bGenerateClearanceField || IsGenerationCancelled() )
+    {
+        for ( auto & layer : SVOData->Layers )
+        {
+            layer.NodeClearances.Empty();
+        }
+
+        leaf_nodes.SubNodeClearances.Empty();
+        return;
+    }
+
+    FSVOGenerationStageScope stage_scope( GetGenerationProgress(), ESVOGenerationStage::ClearanceField );
+
+    // The sub nodes are aligned on multiples of their extent, so testing boxes of that many extents around the centers finds the quantized distance.
+    // The tolerance avoids the boxes which only touch an occluded sub node to overlap it because of the floating point errors
+    const auto clearance_unit = leaf_nodes.GetLeafSubNodeExtent();
+    const auto tolerance = clearance_unit * 0.01f;
+
+    const auto get_clearance = [ & ]( const FVector & position ) -> uint8 {
+        int32 free_distance = 0;
+        int32 occluded_distance = MAX_uint8 + 1;
+
+        while ( occluded_distance - free_distance > 1 )
+        {
+            const auto distance = ( free_distance + occluded_distance ) / 2;
+
+            // The unresolved leaves are considered occluded, so they are not rasterized just to compute the field
+            if ( IsBoxOccluded( FBox::BuildAABB( position, FVector( distance * clearance_unit - tolerance ) ), /*resolve_leaves=*/false ) )
+            {
+                occluded_distance = distance;
+            }
+            else
+            {
+                free_distance = distance;
+            }
+        }
+
+        return static_cast< uint8 >( free_distance );
+    };
+
+    // The existing field can only be patched if it was built for the same nodes
+    auto can_update_incrementally = dirty_bounds.Num() > 0 && leaf_nodes.SubNodeClearances.Num() == SVOData->GetLayer( 0 ).GetNodes().Num() * 64;
+
+    for ( const auto & layer : SVOData->Layers )
+    {
+        can_update_incrementally &= layer.NodeClearances.Num() == layer.GetNodes().Num();
+    }
+
+    // The whole nodes of layer 1 around the dirty bounds are rasterized again, and the clearance of a node only depends on the sub nodes closer than the maximum clearance
+    TArray< FBox > affected_bounds;
+
+    if ( can_update_incrementally )
+    {
+        const auto affected_extent = SVOData->GetLayer( 1 ).GetNodeSize() + Settings.GenerationSettings.Clearance + leaf_nodes.GetLeafNodeSize() + ( MAX_uint8 + 1 ) * clearance_unit;
+
+        for ( const auto & dirty_box : dirty_bounds )
+        {
+            affected_bounds.Emplace( dirty_box.ExpandBy( affected_extent ) );
+        }
+    }
+
+    const auto is_affected = [ & ]( const FVector & position ) {
+        return !can_update_incrementally || affected_bounds.ContainsByPredicate( [ &position ]( const FBox & box ) {
+            return box.IsInsideOrOn( position );
+        } );
+    };
+
+    for ( LayerIndex layer_index = 0; layer_index < GetLayerCount(); ++layer_index )
+    {
+        const auto & layer_nodes = SVOData->GetLayer( layer_index ).GetNodes();
+        auto & node_clearances = SVOData->GetLayer( layer_index ).NodeClearances;
+
+        if ( !can_update_incrementally )
+        {
+            node_clearances.SetNumUninitialized( layer_nodes.Num() );
+        }
+
+        ParallelFor( layer_nodes.Num(), [ & ]( const int32 node_index ) {
+            const auto & node = layer_nodes[ node_index ];
+            const auto position = GetNodePositionFromLayerAndMortonCode( layer_index, node.MortonCode );
+
+            if ( !is_affected( position ) )
+            {
+                return;
+            }
+
+            // Only the free nodes are traversed
+            node_clearances[ node_index ] = !node.HasChildren() && !IsGenerationCancelled()
+                                                ? get_clearance( position )
+                                                : 0;
+        } );
+    }
+
+    const auto & layer_zero_nodes = SVOData->GetLayer( 0 ).GetNodes();
+    const auto & layer_zero_node_clearances = SVOData->GetLayer( 0 ).NodeClearances;
+    const auto leaf_sub_node_size = leaf_nodes.GetLeafSubNodeSize();
+
+    if ( !can_update_incrementally )
+    {
+        leaf_nodes.SubNodeClearances.SetNumUninitialized( layer_zero_nodes.Num() * 64 );
+    }
+
+    ParallelFor( layer_zero_nodes.Num(), [ & ]( const int32 leaf_index ) {
+        const auto & layer_zero_node = layer_zero_nodes[ leaf_index ];
+        auto * sub_node_clearances = leaf_nodes.SubNodeClearances.GetData() + leaf_index * 64;
+
+        if ( !is_affected( GetLeafNodePositionFromMortonCode( layer_zero_node.MortonCode ) ) )
+        {
+            return;
+        }
+
+        // The sub nodes of the free leaves are never used, but keep the clearance of their node
+        if ( !layer_zero_node.HasChildren() || IsGenerationCancelled() )
+        {
+            FMemory::Memset( sub_node_clearances, layer_zero_node_clearances[ leaf_index ], 64 );
+            return;
+        }
+
+        // The sub nodes of the unresolved leaves are considered occluded
+        if ( !leaf_nodes.IsLeafResolved( leaf_index ) )
+        {
+            FMemory::Memset( sub_node_clearances, 0, 64 );
+            return;
+        }
+
+        const auto & leaf_node = leaf_nodes.GetLeafNode( leaf_index );
+        const auto location = GetLeafNodePositionFromMortonCode( layer_zero_node.MortonCode ) - leaf_nodes.GetLeafNodeExtent();
+
+        for ( SubNodeIndex sub_node_index = 0; sub_node_index < 64; ++sub_node_index )
+        {
+            sub_node_clearances[ sub_node_index ] = !leaf_node.IsSubNodeOccluded( sub_node_index )
+                                                        ? get_clearance( location + FSVOHelpers::GetVectorFromMortonCode( sub_node_index ) * leaf_sub_node_size + clearance_unit )
+                                                        : 0;
+        }
+    } );
+}
+
+void FSVOVolumeNavigationData::BuildNeighborLinks( const LayerIndex layer_index )
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_BuildNeighborLinks );
+
+    const auto layer_node_count = SVOData->GetLayer( layer_index ).GetNodes().Num();
+
+    // Each node only writes its own links, and only reads the links of the parent layer, which are built before
+    ParallelFor( layer_node_count, [ & ]( const int32 layer_node_index ) {
+        if ( IsGenerationCancelled() )
+        {
+            return;
+        }
+
+        BuildNodeNeighborLinks( layer_index, layer_node_index );
+    } );
+}
+
+void FSVOVolumeNavigationData::BuildNodeNeighborLinks( const LayerIndex layer_index, const NodeIndex layer_node_index )
+{
+    auto & node = SVOData->GetLayer( layer_index ).GetNodes()[ layer_node_index ];
+
+    for ( NeighborDirection direction = 0; direction < 6; direction++ )
+    {
+        node.Neighbors[ direction ] = FindNeighborInDirection( layer_index, layer_node_index, direction );
+    }
+}
+
+FSVONodeAddress FSVOVolumeNavigationData::FindNeighborInDirection( const LayerIndex layer_index, const NodeIndex node_index, const NeighborDirection direction ) const
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_FindNeighborInDirection );
+
+    const auto & layer = SVOData->GetLayer( layer_index );
+    const auto & layer_nodes = layer.GetNodes();
+    const auto & node = layer_nodes[ node_index ];
+
+    FIntVector neighbor_coords( FSVOHelpers::GetVectorFromMortonCode( node.MortonCode ) );
+    neighbor_coords += NeighborDirections[ direction ];
+
+    if ( neighbor_coords.GetMin() < 0 )
+    {
+        return FSVONodeAddress::InvalidAddress;
+    }
+
+    const auto neighbor_code = FSVOHelpers::GetMortonCodeFromVector( neighbor_coords );
+
+    // The space outside of the volume bounds was not rasterized, so it can't be traversed
+    if ( !IsNodeInVolumeBounds( layer_index, neighbor_code ) )
+    {
+        return FSVONodeAddress::InvalidAddress;
+    }
+
+    const auto neighbor_child_index = static_cast< NodeIndex >( neighbor_code & 7 );
+
+    // The nodes are created by groups of 8 siblings, in morton order, so a sibling is found directly from the index of the node
+    int32 neighbor_node_index = INDEX_NONE;
+
+    if ( FSVOHelpers::GetParentMortonCode( neighbor_code ) == FSVOHelpers::GetParentMortonCode( node.MortonCode ) )
+    {
+        neighbor_node_index = ( node_index & ~7u ) + neighbor_child_index;
+    }
+    else if ( layer_index == GetLayerCount() - 1 )
+    {
+        // The roots have no parent, but they are sorted
+        neighbor_node_index = GetNodeIndexFromMortonCode( layer_index, neighbor_code );
+
+        if ( neighbor_node_index == INDEX_NONE )
+        {
+            return FSVONodeAddress::InvalidAddress;
+        }
+    }
+    else
+    {
+        // Otherwise the parent of the neighbor is the neighbor of the parent. If that one has no children, it is the neighbor of the node
+        check( node.Parent.IsValid() );
+
+        const auto & parent_neighbor_address = SVOData->GetLayer( node.Parent.LayerIndex ).GetNode( node.Parent.NodeIndex ).Neighbors[ direction ];
+
+        if ( !parent_neighbor_address.IsValid() || parent_neighbor_address.LayerIndex != layer_index + 1 )
+        {
+            return parent_neighbor_address;
+        }
+
+        const auto & parent_neighbor = SVOData->GetLayer( parent_neighbor_address.LayerIndex ).GetNode( parent_neighbor_address.NodeIndex );
+
+        if ( !parent_neighbor.HasChildren() )
+        {
+            return parent_neighbor_address;
+        }
+
+        neighbor_node_index = parent_neighbor.FirstChild.NodeIndex + neighbor_child_index;
+    }
+
+    const auto & neighbor_node = layer_nodes[ neighbor_node_index ];
+    checkSlow( neighbor_node.MortonCode == neighbor_code );
+
+    // The leaves which are not resolved yet are linked, their sub nodes are tested when they are traversed.
+    // With several channels, a leaf completely occluded by some of them can be free for the others
+    if ( layer_index == 0 &&
+         CollisionChannels.Num() <= 1 &&
+         neighbor_node.HasChildren() &&
+         SVOData->GetLeafNodes().IsLeafResolved( neighbor_node.FirstChild.NodeIndex ) &&
+         SVOData->GetLeafNodes().GetLeafNode( neighbor_node.FirstChild.NodeIndex ).IsCompletelyOccluded() )
+    {
+        return FSVONodeAddress::InvalidAddress;
+    }
+
+    return FSVONodeAddress( layer_index, neighbor_node_index );
 }
 
-void FSVOVolumeNavigationData::GetLeafNeighbors( TArray< FSVONodeAddress > & neighbors, const FSVONodeAddress & leaf_address ) const
+void FSVOVolumeNavigationData::GetLeafNeighbors( TArray< FSVONodeAddress > & neighbors, const FSVONodeAddress & leaf_address, const uint32 channel_mask ) const
 {
     QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_GetLeafNeighbors );
 
     const MortonCode leaf_index = leaf_address.SubNodeIndex;
     const FSVONode & node = GetNodeFromAddress( leaf_address );
-    const FSVOLeafNode & leaf = SVOData.GetLeafNodes().GetLeafNode( node.FirstChild.NodeIndex );
+    const auto leaf = GetLeafNodeForChannels( node.FirstChild.NodeIndex, channel_mask );
 
     uint_fast32_t x = 0, y = 0, z = 0;
     morton3D_64_decode( leaf_index, x, y, z );
@@ -803,7 +2309,7 @@ void FSVOVolumeNavigationData::GetLeafNeighbors( TArray< FSVONodeAddress > & nei
                 continue;
             }
 
-            const FSVOLeafNode & leaf_node = SVOData.GetLeafNodes().GetLeafNode( neighbor_node.FirstChild.NodeIndex );
+            const auto leaf_node = GetLeafNodeForChannels( neighbor_node.FirstChild.NodeIndex, channel_mask );
 
             // leaf not occluded. Find the correct subnode
             if ( !leaf_node.IsCompletelyOccluded() )
@@ -853,7 +2359,7 @@ void FSVOVolumeNavigationData::GetFreeNodesFromNodeAddress( const FSVONodeAddres
 
     if ( layer_index == 0 )
     {
-        const auto & leaf_node = SVOData.LeafNodes.GetLeafNode( node_index );
+        const auto & leaf_node = GetLeafNode( node_index );
 
         if ( leaf_node.IsCompletelyOccluded() )
         {
@@ -876,7 +2382,7 @@ void FSVOVolumeNavigationData::GetFreeNodesFromNodeAddress( const FSVONodeAddres
     }
     else
     {
-        const auto & node = SVOData.GetLayer( layer_index ).GetNode( node_index );
+        const auto & node = SVOData->GetLayer( layer_index ).GetNode( node_index );
 
         if ( !node.HasChildren() )
         {
@@ -886,27 +2392,36 @@ void FSVOVolumeNavigationData::GetFreeNodesFromNodeAddress( const FSVONodeAddres
         {
             const auto & first_child = node.FirstChild;
             const auto child_layer_index = first_child.LayerIndex;
-            const auto & child_layer = SVOData.GetLayer( child_layer_index );
+            const auto & child_layer = SVOData->GetLayer( child_layer_index );
 
             for ( auto child_index = 0; child_index < 8; ++child_index )
             {
-                const auto & child_node = child_layer.GetNodes()[ first_child.NodeIndex + child_index ];
-                GetFreeNodesFromNodeAddress( FSVONodeAddress( child_layer_index, child_node.MortonCode, 0 ), free_nodes );
+                const auto child_node_index = first_child.NodeIndex + child_index;
+
+                if ( IsNodeInVolumeBounds( child_layer_index, child_layer.GetNode( child_node_index ).MortonCode ) )
+                {
+                    GetFreeNodesFromNodeAddress( FSVONodeAddress( child_layer_index, child_node_index, 0 ), free_nodes );
+                }
             }
         }
     }
 }
 
-void FSVOVolumeNavigationData::BuildParentLinkForLeafNodes( const TMap<LeafIndex, MortonCode> & leaf_index_to_parent_morton_code_map )
+void FSVOVolumeNavigationData::BuildParentLinkForLeafNodes()
 {
-    for ( const auto & key_pair : leaf_index_to_parent_morton_code_map )
-    {
-        auto & leaf_node = SVOData.GetLeafNodes().GetLeafNode( key_pair.Key );
-        leaf_node.Parent.LayerIndex = 1;
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_BuildParentLinkForLeafNodes );
+
+    // Each leaf has the same index as its node of layer 0, and shares its parent of layer 1, which was linked by RasterizeLayer
+    const auto & layer_zero_nodes = SVOData->GetLayer( 0 ).GetNodes();
+    auto & leaf_nodes = SVOData->GetLeafNodes();
 
-        const auto node_index = GetNodeIndexFromMortonCode( 1, key_pair.Value );
-        check( node_index != INDEX_NONE );
+    for ( LeafIndex leaf_index = 0; leaf_index < layer_zero_nodes.Num(); ++leaf_index )
+    {
+        const auto & parent = layer_zero_nodes[ leaf_index ].Parent;
+        check( parent.IsValid() && parent.LayerIndex == 1 );
 
-        leaf_node.Parent.NodeIndex = node_index;
+        auto & leaf_node = leaf_nodes.GetLeafNode( leaf_index );
+        leaf_node.Parent.LayerIndex = 1;
+        leaf_node.Parent.NodeIndex = parent.NodeIndex;
     }
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <Engine/EngineTypes.h>
+
 #include "SVONavigationQueryFilterSettings.generated.h"
 
 class USVOPathHeuristicCalculator;
@@ -35,4 +37,13 @@ struct SVONAVIGATION_API FSVONavigationQueryFilterSettings
     // How many intermediate points we will generate between the points returned by the pathfinding in order to smooth the curve (the bigger, the smoother)
     UPROPERTY( EditDefaultsOnly, meta = ( EditCondition = "bSmoothPaths == true" ) )
     int SmoothingSubdivisions;
+
+    // The nodes whose clearance is lower than this value are not traversed. Usually the radius of the agent, to let agents bigger than the voxels use smaller navigation data.
+    // Requires the clearance field to be generated. 0 means no node is rejected
+    UPROPERTY( EditDefaultsOnly, meta = ( ClampMin = "0", UIMin = "0" ) )
+    float MinimumClearance;
+
+    // The collision channels of the navigation data whose occluded sub nodes can not be traversed. Empty to use all the channels the data was generated with
+    UPROPERTY( EditDefaultsOnly )
+    TArray< TEnumAsByte< ECollisionChannel > > CollisionChannels;
 };
@@ -100,6 +100,8 @@ struct FSVOPathFindingParameters
     const USVOPathHeuristicCalculator * HeuristicCalculator;
     const USVOPathTraversalCostCalculator * CostCalculator;
     const FSVOVolumeNavigationData & VolumeNavigationData;
+    // Mask of the collision channels of the navigation data which block the query. See FSVOVolumeNavigationData::GetCollisionChannelMask
+    uint32 CollisionChannelMask;
     FSVONodeAddress StartNodeAddress;
     FSVONodeAddress EndNodeAddress;
 
@@ -44,4 +44,29 @@ private:
 
     UPROPERTY( EditDefaultsOnly )
     float Cost;
+};
+
+/*
+ * Multiplies the distance between the nodes by a factor which grows when the clearance of the end node is lower than PreferredClearance.
+ * This keeps the paths away from the obstacles when possible. Requires the clearance field to be generated, and behaves like the distance calculator otherwise.
+ */
+UCLASS()
+class SVONAVIGATION_API USVOPathCostCalculator_Clearance final : public USVOPathTraversalCostCalculator
+{
+    GENERATED_BODY()
+
+public:
+
+    USVOPathCostCalculator_Clearance();
+
+    float GetTraversalCost( const FSVOVolumeNavigationData & bounds_data, const FSVONodeAddress & start, const FSVONodeAddress & end ) const override;
+
+private:
+
+    UPROPERTY( EditDefaultsOnly, meta = ( ClampMin = "0", UIMin = "0" ) )
+    float PreferredClearance;
+
+    // Factor applied to the distance when the clearance of the end node is 0
+    UPROPERTY( EditDefaultsOnly, meta = ( ClampMin = "1", UIMin = "1" ) )
+    float MaxCostMultiplier;
 };
\ No newline at end of file
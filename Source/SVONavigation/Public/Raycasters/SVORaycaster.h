@@ -61,12 +61,13 @@ class SVONAVIGATION_API USVORayCaster : public UObject
     GENERATED_BODY()
 
 public:
-    bool Trace( const FSVOVolumeNavigationData & volume_navigation_data, const FVector & from, const FVector & to ) const;
+    // The sub nodes are only considered occluded by the collision channels of the mask. See FSVOVolumeNavigationData::GetCollisionChannelMask
+    bool Trace( const FSVOVolumeNavigationData & volume_navigation_data, const FVector & from, const FVector & to, uint32 channel_mask = MAX_uint32 ) const;
 
     void SetObserver( TSharedPtr< FSVORayCasterObserver > observer );
 
 protected:
-    virtual bool TraceInternal( const FSVOVolumeNavigationData & volume_navigation_data, const FVector & from, const FVector & to ) const;
+    virtual bool TraceInternal( const FSVOVolumeNavigationData & volume_navigation_data, const FVector & from, const FVector & to, uint32 channel_mask ) const;
 
     static UWorld * GetWorldContext();
 
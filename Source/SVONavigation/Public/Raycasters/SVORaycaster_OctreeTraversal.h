@@ -13,7 +13,7 @@ class SVONAVIGATION_API USVORayCaster_OctreeTraversal final : public USVORayCast
 
 protected:
 
-    bool TraceInternal( const FSVOVolumeNavigationData & volume_navigation_data, const FVector & from, const FVector & to ) const override;
+    bool TraceInternal( const FSVOVolumeNavigationData & volume_navigation_data, const FVector & from, const FVector & to, uint32 channel_mask ) const override;
 
 private:
 
@@ -37,6 +37,7 @@ private:
     static uint8 GetFirstNodeIndex( const FOctreeRay & ray );
     static uint8 GetNextNodeIndex( float txm, int32 x, float tym, int32 y, float tzm, int32 z );
 
+    bool DoesRayIntersectOccludedRoot( const FSVONodeAddress & root_address, const FBox & root_bounds, const FVector & from, const FVector & to, const FSVOVolumeNavigationData & data ) const;
     bool DoesRayIntersectOccludedSubNode( const FOctreeRay & ray, const FSVONodeAddress & node_address, const NodeIndex leaf_sub_node_index, const FSVOVolumeNavigationData & data ) const;
     bool DoesRayIntersectOccludedLeaf( const FOctreeRay & ray, const FSVONodeAddress & node_address, const FSVOVolumeNavigationData & data ) const;
     bool DoesRayIntersectOccludedNormalNode( const FOctreeRay & ray, const FSVONodeAddress & node_address, const FSVOVolumeNavigationData & data ) const;
@@ -44,4 +45,6 @@ private:
 
     mutable uint8 a = 0;
     mutable float RaySize = 0.0f;
+    // The collision channels of the current trace
+    mutable uint32 ChannelMask = MAX_uint32;
 };
\ No newline at end of file
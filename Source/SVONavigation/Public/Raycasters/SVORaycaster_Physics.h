@@ -13,7 +13,8 @@ class SVONAVIGATION_API USVORayCaster_PhysicsBase : public USVORayCaster
 
 protected:
 
-    bool TraceInternal( const FSVOVolumeNavigationData & volume_navigation_data, const FVector & from, const FVector & to ) const override;
+    // The physics traces use their own trace type, so the channel mask is ignored
+    bool TraceInternal( const FSVOVolumeNavigationData & volume_navigation_data, const FVector & from, const FVector & to, uint32 channel_mask ) const override;
 
     virtual bool TracePhysicsInternal( const FVector & from, const FVector & to ) const;
 
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "SVONavigationTypes.h"
+
+#include <CoreMinimal.h>
+
+class UBodySetup;
+class UPrimitiveComponent;
+
+// A copy of the collision geometry of the primitives which can affect the navigation in some bounds.
+// It is captured once on the game thread, and can then be tested for overlaps from any thread without using the physics scene.
+// Boxes, spheres, capsules and convex elements of the simple collision are supported, as well as the triangles of the meshes which use their complex collision as simple.
+class SVONAVIGATION_API FSVOCollisionGeometrySnapshot
+{
+public:
+    FSVOCollisionGeometrySnapshot();
+
+    void Gather( const UWorld & world, const FBox & bounds, const FSVODataGenerationSettings & generation_settings );
+    bool IsBoxOccluded( const FBox & box ) const;
+    bool IsEmpty() const;
+    int GetShapeCount() const;
+    int GetAllocatedSize() const;
+
+    static void GatherPrimitiveComponents( TArray< const UPrimitiveComponent * > & primitive_components, const UWorld & world, const FBox & bounds, const FSVODataGenerationSettings & generation_settings );
+
+private:
+    enum class EShapeType : uint8
+    {
+        Sphere,
+        Capsule,
+        Convex,
+        Triangle
+    };
+
+    struct FShape
+    {
+        FBox Bounds;
+        // Sphere and capsule
+        FVector Start;
+        FVector End;
+        float Radius;
+        // Convex and triangle
+        int32 FirstTriangle;
+        int32 TriangleCount;
+        int32 FirstPlane;
+        int32 PlaneCount;
+        EShapeType Type;
+    };
+
+    void AddBodySetup( const UBodySetup & body_setup, const FTransform & component_transform );
+    void AddSphere( const FVector & start, const FVector & end, float radius );
+    void AddConvex( const TArray< FVector > & vertices, const TArray< int32 > & indices );
+    void AddTriangleMesh( const TArray< FVector > & vertices, const TArray< int32 > & indices );
+    void BuildGrid();
+    bool DoesShapeOverlapBox( const FShape & shape, const FVector & box_center, const FVector & box_extent ) const;
+
+    TArray< FShape > Shapes;
+    // 3 consecutive vertices per triangle
+    TArray< FVector > TriangleVertices;
+    // Planes of the faces of the convex shapes, pointing outside
+    TArray< FPlane > Planes;
+
+    // Uniform grid used to only test the shapes near the tested boxes
+    FBox GridBounds;
+    FIntVector GridSize;
+    float GridCellSize;
+    TArray< int32 > GridCellFirstShapeIndices;
+    TArray< int32 > GridCellShapeIndices;
+};
+
+FORCEINLINE bool FSVOCollisionGeometrySnapshot::IsEmpty() const
+{
+    return Shapes.Num() == 0;
+}
+
+FORCEINLINE int FSVOCollisionGeometrySnapshot::GetShapeCount() const
+{
+    return Shapes.Num();
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+class FSVOVolumeNavigationData;
+
+// Local cache of generated volume navigation data, in a directory which can be shared between branches and machines.
+// The files are named after the hash of the inputs of the generation and the data version, so the data of a file never needs to be invalidated
+class SVONAVIGATION_API FSVOGenerationCache
+{
+public:
+    // Empty when the cache is disabled in the settings, or when the hash is unknown. Must be called on the game thread
+    static FString GetFilePath( uint64 input_hash );
+
+    // Only succeeds if the file contains valid data of the volume generated from the same inputs
+    static bool Load( FSVOVolumeNavigationData & data, const FString & file_path, uint64 input_hash, const FBox & volume_bounds );
+
+    // Writes a temporary file first, then moves it to its final path, so the other readers of the cache never see a partially written file
+    static bool Save( FSVOVolumeNavigationData & data, const FString & file_path );
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+struct FSVOVolumeGenerationProgressInfo;
+
+// Hashes the bounds of the volumes, so the elements of a volume can be found without iterating over all the volumes
+template < typename TValue >
+struct TSVOVolumeBoundsKeyFuncs : TDefaultMapKeyFuncs< FBox, TValue, false >
+{
+    static FORCEINLINE uint32 GetKeyHash( const FBox & volume_bounds )
+    {
+        return HashCombine( GetTypeHash( volume_bounds.GetCenter() ), GetTypeHash( volume_bounds.GetExtent() ) );
+    }
+};
+
+template < typename TValue >
+using TSVOVolumeBoundsMap = TMap< FBox, TValue, FDefaultSetAllocator, TSVOVolumeBoundsKeyFuncs< TValue > >;
+
+// Estimates how long the generation of a volume takes, from the generations which already finished.
+// The work is counted in occlusion tests: one per node of layer 1 during the first pass, and one per sub node of the occluded leaves.
+// The time of an occlusion test and the ratio of occluded leaves of each volume are measured when the generations finish
+class SVONAVIGATION_API FSVOGenerationCostModel
+{
+public:
+    FSVOGenerationCostModel();
+
+    // In seconds of work of a single thread, the tiles being generated in parallel. generated_volume is the volume of the space which is rasterized : the whole volume, its dirty bounds or its invoker cells
+    double EstimateCost( const FBox & volume_bounds, double generated_volume, float leaf_size ) const;
+    // is_whole_volume must be false for the incremental updates, as their ratio of occluded leaves is not the ratio of the volume
+    void AddSample( const FBox & volume_bounds, double generated_volume, float leaf_size, bool is_whole_volume, const FSVOVolumeGenerationProgressInfo & progress_info );
+
+private:
+    TSVOVolumeBoundsMap< float > VolumeOccludedLeafRatios;
+    // Used for the volumes which were never generated
+    float AverageOccludedLeafRatio;
+    double SecondsPerOcclusionTest;
+    int32 SampleCount;
+};
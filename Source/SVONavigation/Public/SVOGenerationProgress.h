@@ -0,0 +1,118 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+#include <atomic>
+
+enum class ESVOGenerationStage : uint8
+{
+    Pending,
+    FirstPass,
+    LeafRasterization,
+    LayerBuild,
+    ParentLinks,
+    NeighborLinks,
+    ClearanceField,
+    Finished,
+    Count
+};
+
+SVONAVIGATION_API const TCHAR * LexToString( ESVOGenerationStage stage );
+
+// Copy of the progress of the generation of a volume at some point in time
+struct SVONAVIGATION_API FSVOVolumeGenerationProgressInfo
+{
+    FSVOVolumeGenerationProgressInfo();
+
+    // Rough ratio in [0;1], mostly driven by the rasterization which is by far the longest part of the generation
+    float GetCompletionRatio() const;
+    double GetStageTime( ESVOGenerationStage stage ) const;
+
+    FBox VolumeBounds;
+    // The most advanced stage which started. As the tiles are rasterized in parallel, earlier stages can still be running
+    ESVOGenerationStage Stage;
+    int32 TilesDone;
+    int32 TileCount;
+    int32 LeavesRasterized;
+    // Grows while the tiles find occluded nodes
+    int32 LeavesExpected;
+    double ElapsedTime;
+    // Sum of the time spent by the tasks in the stages, on all the threads. Unlike ElapsedTime, it does not include the time spent waiting for a worker
+    double TaskTime;
+    // Negative when it can't be estimated yet
+    double EstimatedRemainingTime;
+    // Wall clock time between the start of the first task and the end of the last task of each stage
+    double StageTimes[ static_cast< int32 >( ESVOGenerationStage::Count ) ];
+    // In bytes, only known once the layers are built. The peak includes the tiles, the scratch data and the new data before it is shrunk
+    int64 PeakMemory;
+    // In bytes, what the new data keeps allocated
+    int64 RetainedMemory;
+};
+
+// Progress of the generation of a volume. It is updated by the tasks generating the data, and can be read from any thread
+class SVONAVIGATION_API FSVOGenerationProgress
+{
+public:
+    FSVOGenerationProgress();
+
+    void SetTileCount( int32 tile_count );
+    void OnTileDone();
+    void AddExpectedLeaves( int32 leaf_count );
+    void AddRasterizedLeaves( int32 leaf_count );
+    void BeginStage( ESVOGenerationStage stage );
+    void EndStage( ESVOGenerationStage stage );
+    void AddTaskCycles( uint64 cycles );
+    void SetMemoryUsage( int64 peak_memory, int64 retained_memory );
+    void Finish();
+
+    FSVOVolumeGenerationProgressInfo GetInfo() const;
+
+private:
+    std::atomic< uint8 > Stage;
+    std::atomic< int32 > TilesDone;
+    std::atomic< int32 > TileCount;
+    std::atomic< int32 > LeavesRasterized;
+    std::atomic< int32 > LeavesExpected;
+    std::atomic< uint64 > StageStartCycles[ static_cast< int32 >( ESVOGenerationStage::Count ) ];
+    std::atomic< uint64 > StageEndCycles[ static_cast< int32 >( ESVOGenerationStage::Count ) ];
+    std::atomic< uint64 > FinishCycles;
+    std::atomic< uint64 > TaskCycles;
+    std::atomic< int64 > PeakMemory;
+    std::atomic< int64 > RetainedMemory;
+    uint64 StartCycles;
+};
+
+// Marks a stage as running for the lifetime of the scope. The progress can be null
+class FSVOGenerationStageScope final : public FNoncopyable
+{
+public:
+    FSVOGenerationStageScope( FSVOGenerationProgress * progress, const ESVOGenerationStage stage ) :
+        Progress( progress ),
+        Stage( stage ),
+        StartCycles( FPlatformTime::Cycles64() )
+    {
+        if ( Progress != nullptr )
+        {
+            Progress->BeginStage( Stage );
+        }
+    }
+
+    ~FSVOGenerationStageScope()
+    {
+        if ( Progress != nullptr )
+        {
+            Progress->EndStage( Stage );
+            Progress->AddTaskCycles( FPlatformTime::Cycles64() - StartCycles );
+        }
+    }
+
+private:
+    FSVOGenerationProgress * Progress;
+    ESVOGenerationStage Stage;
+    uint64 StartCycles;
+};
+
+FORCEINLINE double FSVOVolumeGenerationProgressInfo::GetStageTime( const ESVOGenerationStage stage ) const
+{
+    return StageTimes[ static_cast< int32 >( stage ) ];
+}
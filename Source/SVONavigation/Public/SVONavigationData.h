@@ -157,9 +157,11 @@ public:
         }
     }
 
+    // Replaces the data of the same volume if there is one
     void AddVolumeNavigationData( FSVOVolumeNavigationData data );
     const FSVOVolumeNavigationData * GetVolumeNavigationDataContainingPoints( const TArray< FVector > & points ) const;
     void UpdateNavVersion();
+    void GetGenerationProgress( TArray< FSVOVolumeGenerationProgressInfo > & progress_infos ) const;
 
 private:
     void SerializeSVOData( FArchive & archive, ESVOVersion version );
@@ -193,6 +195,20 @@ private:
     UPROPERTY( EditAnywhere, Category = "Generation", config, meta = ( ClampMin = "0", UIMin = "0" ), AdvancedDisplay )
     int32 MaxSimultaneousBoxGenerationJobsCount;
 
+    // Maximum time in milliseconds spent each frame on the game thread to apply the results of the generation. At least one result is applied each frame. 0 means no limit
+    UPROPERTY( EditAnywhere, Category = "Generation", config, meta = ( ClampMin = "0", UIMin = "0" ), AdvancedDisplay )
+    float MaxResultsApplyTimePerFrame;
+
+    // When the navigation system only generates the navigation around the navigation invokers, the volumes are split in cubes of that size.
+    // The cubes within the generation radius of an invoker are generated, and the ones out of the removal radius of all the invokers are removed
+    UPROPERTY( EditAnywhere, Category = "Generation", config, meta = ( ClampMin = "100", UIMin = "100" ), AdvancedDisplay )
+    float InvokerCellSize;
+
+    // The dirty areas are accumulated and merged, and the volumes they touch are only rebuilt once the areas did not change during that time in seconds.
+    // This avoids rebuilding the same area many times per second while physics simulated or animated actors move. 0 rebuilds the dirty areas right away
+    UPROPERTY( EditAnywhere, Category = "Generation", config, meta = ( ClampMin = "0", UIMin = "0" ), AdvancedDisplay )
+    float DirtyAreasDebounceTime;
+
     TArray< FSVOVolumeNavigationData > VolumeNavigationData;
     ESVOVersion Version;
 };
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "SVOGenerationCostModel.h"
+#include "SVOGenerationProgress.h"
 #include "SVONavigationData.h"
 #include "SVONavigationTypes.h"
 
@@ -12,11 +14,23 @@ class FSVONavigationDataGenerator;
 struct FSVOVolumeNavigationDataGenerator final : public FNoncopyable
 {
 public:
-    FSVOVolumeNavigationDataGenerator( FSVONavigationDataGenerator & navigation_data_generator, const FBox & volume_bounds );
+    // When dirty_bounds is not empty and the volume already has valid navigation data, only the dirty bounds are rasterized again
+    FSVOVolumeNavigationDataGenerator( FSVONavigationDataGenerator & navigation_data_generator, const FBox & volume_bounds, const TArray< FBox > & dirty_bounds );
 
     FSVOVolumeNavigationData GetBoundsNavigationData() const;
-
+    // True when the inputs of the generation did not change since the existing data of the volume was generated. Nothing needs to run then
+    bool IsUpToDate() const;
+    // True when the stitch task loaded the data from the generation cache instead of generating it
+    bool IsLoadedFromCache() const;
+    int32 GetTileCount() const;
+    const FSVOGenerationProgress & GetProgress() const;
+
+    // Can be called concurrently for the different tiles
+    void RasterizeTile( int32 tile_index );
+    // Stitches the tiles together once they are all rasterized
     bool DoWork();
+    // Makes the running tasks of this generator stop as soon as possible. The generated data is then invalid
+    void Cancel();
 
 private:
     FSVONavigationDataGenerator & ParentGenerator;
@@ -24,6 +38,17 @@ private:
     FBox VolumeBounds;
     TWeakObjectPtr< UWorld > World;
     FNavDataConfig NavDataConfig;
+    FSVOVolumeNavigationDataGenerationSettings DataGenerationSettings;
+    TArray< FSVOVolumeNavigationDataTile > Tiles;
+    TArray< FBox > DirtyBounds;
+    FSVOGenerationCancellationToken CancellationToken;
+    TSharedRef< FSVOGenerationProgress, ESPMode::ThreadSafe > Progress;
+    // Where the generated data is stored when the generation cache is enabled
+    FString CacheFilePath;
+    bool bIsUpToDate;
+    // Set on the game thread when the cache file exists. The stitch task then loads it, and only rasterizes the volume if the file is invalid
+    bool bShouldLoadFromCache;
+    bool bIsLoadedFromCache;
 };
 
 FORCEINLINE FSVOVolumeNavigationData FSVOVolumeNavigationDataGenerator::GetBoundsNavigationData() const
@@ -31,6 +56,50 @@ FORCEINLINE FSVOVolumeNavigationData FSVOVolumeNavigationDataGenerator::GetBound
     return BoundsNavigationData;
 }
 
+FORCEINLINE bool FSVOVolumeNavigationDataGenerator::IsUpToDate() const
+{
+    return bIsUpToDate;
+}
+
+FORCEINLINE bool FSVOVolumeNavigationDataGenerator::IsLoadedFromCache() const
+{
+    return bIsLoadedFromCache;
+}
+
+FORCEINLINE int32 FSVOVolumeNavigationDataGenerator::GetTileCount() const
+{
+    return Tiles.Num();
+}
+
+FORCEINLINE const FSVOGenerationProgress & FSVOVolumeNavigationDataGenerator::GetProgress() const
+{
+    return *Progress;
+}
+
+struct SVONAVIGATION_API FSVOTileGeneratorWrapper : public FNonAbandonableTask
+{
+    TSharedRef< FSVOVolumeNavigationDataGenerator > BoxNavigationDataGenerator;
+    int32 TileIndex;
+
+    FSVOTileGeneratorWrapper( const TSharedRef< FSVOVolumeNavigationDataGenerator > box_navigation_generator, const int32 tile_index ) :
+        BoxNavigationDataGenerator( box_navigation_generator ),
+        TileIndex( tile_index )
+    {
+    }
+
+    void DoWork()
+    {
+        BoxNavigationDataGenerator->RasterizeTile( TileIndex );
+    }
+
+    FORCEINLINE TStatId GetStatId() const
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT( FSVOTileGenerator, STATGROUP_ThreadPoolAsyncTasks );
+    }
+};
+
+typedef FAsyncTask< FSVOTileGeneratorWrapper > FSVOTileGeneratorTask;
+
 struct SVONAVIGATION_API FSVOBoxGeneratorWrapper : public FNonAbandonableTask
 {
     TSharedRef< FSVOVolumeNavigationDataGenerator > BoxNavigationDataGenerator;
@@ -56,32 +125,33 @@ typedef FAsyncTask< FSVOBoxGeneratorWrapper > FSVOBoxGeneratorTask;
 struct FPendingBoundsDataGenerationElement
 {
     FBox VolumeBounds;
-    float SeedDistance;
+    // The areas of the volume to update. Empty when the whole volume must be generated
+    TArray< FBox > DirtyBounds;
+    // In seconds, see FSVOGenerationCostModel
+    double EstimatedCost;
+    // The volumes with the smallest priority are generated first
+    double Priority;
+    // Used to compute the latency until the results are applied
+    double QueueTime;
 
     FPendingBoundsDataGenerationElement() :
         VolumeBounds( EForceInit::ForceInit ),
-        SeedDistance( MAX_flt )
-    {
-    }
-
-    bool operator==( const FBox & other_box ) const
-    {
-        return VolumeBounds == other_box;
-    }
-
-    bool operator==( const FPendingBoundsDataGenerationElement & other ) const
+        EstimatedCost( 0.0 ),
+        Priority( 0.0 ),
+        QueueTime( 0.0 )
     {
-        return VolumeBounds == other.VolumeBounds;
     }
+};
 
-    bool operator<( const FPendingBoundsDataGenerationElement & other ) const
-    {
-        return other.SeedDistance < SeedDistance;
-    }
+// Entry of the priority queue of the pending volumes
+struct FSVOPendingVolumePriority
+{
+    FBox VolumeBounds;
+    double Priority;
 
-    friend uint32 GetTypeHash( const FPendingBoundsDataGenerationElement & element )
+    bool operator<( const FSVOPendingVolumePriority & other ) const
     {
-        return HashCombine( GetTypeHash( element.VolumeBounds.GetCenter() ), GetTypeHash( element.VolumeBounds.GetExtent() ) );
+        return Priority < other.Priority;
     }
 };
 
@@ -90,6 +160,10 @@ struct FRunningBoundsDataGenerationElement
     FRunningBoundsDataGenerationElement() :
         VolumeBounds( EForceInit::ForceInit ),
         ShouldDiscard( false ),
+        QueueTime( 0.0 ),
+        Priority( 0.0 ),
+        GeneratedVolume( 0.0 ),
+        NextTileIndex( 0 ),
         AsyncTask( nullptr )
     {
     }
@@ -97,6 +171,10 @@ struct FRunningBoundsDataGenerationElement
     FRunningBoundsDataGenerationElement( const FBox & volume_bounds ) :
         VolumeBounds( volume_bounds ),
         ShouldDiscard( false ),
+        QueueTime( 0.0 ),
+        Priority( 0.0 ),
+        GeneratedVolume( 0.0 ),
+        NextTileIndex( 0 ),
         AsyncTask( nullptr )
     {
     }
@@ -106,12 +184,71 @@ struct FRunningBoundsDataGenerationElement
         return VolumeBounds == other.VolumeBounds;
     }
 
+    bool AreTasksDone() const
+    {
+        return ( AsyncTask == nullptr || AsyncTask->IsDone() ) && !TileTasks.ContainsByPredicate( []( const FSVOTileGeneratorTask * tile_task ) {
+            return !tile_task->IsDone();
+        } );
+    }
+
+    // Waits for the tasks which already started, and deletes all the tasks
+    void DeleteTasks()
+    {
+        for ( auto * tile_task : TileTasks )
+        {
+            if ( !tile_task->Cancel() )
+            {
+                tile_task->EnsureCompletion();
+            }
+            delete tile_task;
+        }
+        TileTasks.Reset();
+
+        if ( AsyncTask != nullptr )
+        {
+            if ( !AsyncTask->Cancel() )
+            {
+                AsyncTask->EnsureCompletion();
+            }
+            delete AsyncTask;
+            AsyncTask = nullptr;
+        }
+    }
+
     FBox VolumeBounds;
+    // The dirty bounds of the pending element this element was created from
+    TArray< FBox > DirtyBounds;
     /** whether generated results should be discarded */
     bool ShouldDiscard;
+    double QueueTime;
+    // The priority of the pending element, used to start the tile tasks of the most urgent volumes first
+    double Priority;
+    // The volume of the space which is rasterized, used to measure the cost of the generation
+    double GeneratedVolume;
+    TSharedPtr< FSVOVolumeNavigationDataGenerator > BoxNavigationDataGenerator;
+    // The tiles are started by batches, and AsyncTask stitches them together once they are all done
+    TArray< FSVOTileGeneratorTask * > TileTasks;
+    int32 NextTileIndex;
     FSVOBoxGeneratorTask * AsyncTask;
 };
 
+// The cells of the grid around the navigation invokers a volume is generated in
+struct FSVOVolumeInvokerCells
+{
+    FBox VolumeBounds;
+    // Sorted, so they can be compared and hashed
+    TArray< FBox > Cells;
+};
+
+// A dirty area waiting for the areas around it to stop changing, see ASVONavigationData::DirtyAreasDebounceTime
+struct FSVODebouncedDirtyArea
+{
+    FBox Bounds;
+    int32 Flags;
+    double FirstDirtyTime;
+    double LastDirtyTime;
+};
+
 class SVONAVIGATION_API FSVONavigationDataGenerator final : public FNavDataGenerator, public FNoncopyable
 {
 public:
@@ -133,24 +270,56 @@ public:
     int32 GetNumRemaningBuildTasks() const override;
     int32 GetNumRunningBuildTasks() const override;
 
+    // Progress of the volumes which are waiting to be generated or being generated. Must be called on the game thread
+    void GetGenerationProgress( TArray< FSVOVolumeGenerationProgressInfo > & progress_infos ) const;
+    bool IsGeneratingVolume( const FBox & volume_bounds ) const;
+    // The navigation data of the smallest agent, when the occlusion source is FinestNavigationData and the owner is not that navigation data
+    ASVONavigationData * GetFinestNavigationData() const;
+    // True when the navigation system only generates the navigation around the navigation invokers. Only in game worlds with a dynamic runtime generation
+    bool IsGeneratingAroundInvokersOnly() const;
+    // The cells of the volume the navigation invokers need. Empty when the navigation is not only generated around the invokers
+    TArray< FBox > GetInvokerCells( const FBox & volume_bounds ) const;
+
 private:
-    void GetSeedLocations( TArray< FVector2D > & seed_locations, UWorld & world ) const;
-    void SortPendingBounds();
+    void GetSeedLocations( TArray< FVector > & seed_locations, UWorld & world ) const;
+    // Queues the generation of the volumes touched by the dirty areas, without waiting for them to stop changing
+    void QueueDirtyAreas( const TArray< FNavigationDirtyArea > & dirty_areas );
+    // Queues the debounced dirty areas which did not change during the debounce time, or all of them
+    void SubmitDebouncedDirtyAreas( bool submit_all );
+    // Recomputes the priorities of the pending volumes from their distance to the seed locations and their estimated cost
+    void UpdatePendingPriorities();
+    // Starts the tile tasks of the running volumes by priority, as long as less than MaximumTileTaskCount tile tasks are running
+    void StartTileTasks();
+    // The volume of the space rasterized by a generation : the dirty bounds, the invoker cells or the whole volume
+    double GetGeneratedVolume( const FBox & volume_bounds, const TArray< FBox > & dirty_bounds ) const;
+    float GetLeafSize() const;
     void UpdateNavigationBounds();
-    TArray< FBox > ProcessAsyncTasks( int32 task_to_process_count );
-    TSharedRef< FSVOVolumeNavigationDataGenerator > CreateBoxNavigationGenerator( const FBox & box );
+    // apply_time_budget is in seconds. 0 means all the finished results are applied
+    TArray< FBox > ProcessAsyncTasks( int32 task_to_process_count, double apply_time_budget = 0.0 );
+    TSharedRef< FSVOVolumeNavigationDataGenerator > CreateBoxNavigationGenerator( const FBox & box, const TArray< FBox > & dirty_bounds );
+    bool CanUpdateVolumeIncrementally( const FBox & volume_bounds, const FBox & dirty_bounds ) const;
+    // The volumes are only generated once the finest navigation data is done with them, since their occlusion is derived from it
+    bool IsWaitingForFinestNavigationData( const FBox & volume_bounds ) const;
+    // Marks dirty the cells which entered the generation radius of an invoker, and the cells which left the removal radius of all the invokers
+    void UpdateInvokerCells();
 
     ASVONavigationData & NavigationData;
     FSVODataGenerationSettings GenerationSettings;
     int MaximumGeneratorTaskCount;
+    // Enough to keep the worker threads busy between two ticks, while the tiles of the volumes queued later don't wait behind all the tiles of the big volumes
+    int MaximumTileTaskCount;
     uint8 IsInitialized : 1;
 
     /** Total bounding box that includes all volumes, in unreal units. */
     FBox TotalNavigationBounds;
 
     TNavStatArray< FBox > RegisteredNavigationBounds;
-    TNavStatArray< FPendingBoundsDataGenerationElement > PendingBoundsDataGenerationElements;
+    TSVOVolumeBoundsMap< FPendingBoundsDataGenerationElement > PendingBoundsDataGenerationElements;
     TNavStatArray< FRunningBoundsDataGenerationElement > RunningBoundsDataGenerationElements;
+    TArray< FSVOVolumeInvokerCells > VolumeInvokerCells;
+    // The areas never overlap each other
+    TArray< FSVODebouncedDirtyArea > DebouncedDirtyAreas;
+    FSVOGenerationCostModel CostModel;
 };
 
 FORCEINLINE const ASVONavigationData * FSVONavigationDataGenerator::GetOwner() const
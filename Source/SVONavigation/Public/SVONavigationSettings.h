@@ -2,6 +2,7 @@
 
 #include <CoreMinimal.h>
 #include <Engine/DeveloperSettings.h>
+#include <Engine/EngineTypes.h>
 
 #include "SVONavigationSettings.generated.h"
 
@@ -25,4 +26,13 @@ public:
     // If that option is not set, the pathfinding will be always executed.
     UPROPERTY( config, EditAnywhere, Category = "PathFinding" )
     TSubclassOf< USVORayCaster > DefaultRaycasterClass;
+
+    // If set to true, the generated data of the volumes is stored in a local cache, named after the hash of the inputs of the generation.
+    // Volumes whose inputs match a file of the cache are loaded from it instead of being generated (after switching branches, reloading a map...)
+    UPROPERTY( config, EditAnywhere, Category = "Generation Cache" )
+    uint8 bUseGenerationCache : 1;
+
+    // Directory of the generation cache. It can be on a shared drive to share the cache between machines. Saved/SVONavigationCache when empty
+    UPROPERTY( config, EditAnywhere, Category = "Generation Cache", meta = ( EditCondition = "bUseGenerationCache" ) )
+    FDirectoryPath GenerationCacheDirectory;
 };
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <Stats/Stats.h>
+
+DECLARE_STATS_GROUP( TEXT( "SVONavigation" ), STATGROUP_SVONavigation, STATCAT_Advanced );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Pending volume generations" ), STAT_SVONavigation_PendingGenerationCount, STATGROUP_SVONavigation, SVONAVIGATION_API );
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Running volume generations" ), STAT_SVONavigation_RunningGenerationCount, STATGROUP_SVONavigation, SVONAVIGATION_API );
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Running tile tasks" ), STAT_SVONavigation_RunningTileTaskCount, STATGROUP_SVONavigation, SVONAVIGATION_API );
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Debounced dirty areas" ), STAT_SVONavigation_DebouncedDirtyAreaCount, STATGROUP_SVONavigation, SVONAVIGATION_API );
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Results waiting to be applied" ), STAT_SVONavigation_WaitingResultCount, STATGROUP_SVONavigation, SVONAVIGATION_API );
+// Time between a volume being queued for generation and its results being applied to the navigation data
+DECLARE_FLOAT_COUNTER_STAT_EXTERN( TEXT( "Last apply latency (ms)" ), STAT_SVONavigation_ApplyLatency, STATGROUP_SVONavigation, SVONAVIGATION_API );
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Leaves rasterized" ), STAT_SVONavigation_LeavesRasterized, STATGROUP_SVONavigation, SVONAVIGATION_API );
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Leaves expected" ), STAT_SVONavigation_LeavesExpected, STATGROUP_SVONavigation, SVONAVIGATION_API );
+// Longest estimated remaining time of the running volume generations
+DECLARE_FLOAT_COUNTER_STAT_EXTERN( TEXT( "Estimated remaining time (s)" ), STAT_SVONavigation_EstimatedRemainingTime, STATGROUP_SVONavigation, SVONAVIGATION_API );
+// Memory used by the generation of the last volume whose data was applied
+DECLARE_MEMORY_STAT_EXTERN( TEXT( "Last generation peak memory" ), STAT_SVONavigation_LastGenerationPeakMemory, STATGROUP_SVONavigation, SVONAVIGATION_API );
+DECLARE_MEMORY_STAT_EXTERN( TEXT( "Last generation retained memory" ), STAT_SVONavigation_LastGenerationRetainedMemory, STATGROUP_SVONavigation, SVONAVIGATION_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Apply generation results" ), STAT_SVONavigation_ApplyResults, STATGROUP_SVONavigation, SVONAVIGATION_API );
+// Rasterization of the sub nodes of the leaves rasterized lazily, the first time a query needs them
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Resolve lazy leaves" ), STAT_SVONavigation_ResolveLeaf, STATGROUP_SVONavigation, SVONAVIGATION_API );
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Lazy leaves resolved" ), STAT_SVONavigation_ResolvedLeafCount, STATGROUP_SVONavigation, SVONAVIGATION_API );
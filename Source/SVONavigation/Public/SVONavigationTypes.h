@@ -2,6 +2,8 @@
 
 #include <CoreMinimal.h>
 
+#include <atomic>
+
 #include "SVONavigationTypes.generated.h"
 
 class USVOPathFindingAlgorithm;
@@ -17,6 +19,30 @@ typedef uint8 NeighborDirection;
 
 DECLARE_DELEGATE_ThreeParams( FSVONavigationPathQueryDelegate, uint32, ENavigationQueryResult::Type, FNavPathSharedPtr );
 
+// Shared between a generator and the tasks generating the data, to stop them as soon as possible when their results are not needed anymore
+typedef TSharedPtr< std::atomic< bool >, ESPMode::ThreadSafe > FSVOGenerationCancellationToken;
+
+UENUM()
+enum class ESVOOcclusionSource : uint8
+{
+    // Overlap queries against the physics scene
+    PhysicsScene,
+    // Copy of the collision geometry captured before the generation starts, which does not use the physics scene
+    CollisionGeometrySnapshot,
+    // Occlusion derived from the data of the same volume generated for the smallest agent, which does not use the physics scene.
+    // Uses the physics scene when there is no SVO navigation data for a smaller agent
+    FinestNavigationData
+};
+
+UENUM()
+enum class ESVOResolution : uint8
+{
+    // The occluded nodes of layer 1 are subdivided in leaves, whose sub nodes are rasterized
+    Full,
+    // The occluded nodes of layer 1 are not subdivided further. Their leaves are considered completely occluded, and are not rasterized
+    Coarse
+};
+
 USTRUCT()
 struct FSVODataGenerationSettings
 {
@@ -26,18 +52,79 @@ struct FSVODataGenerationSettings
     {
         CollisionChannel = ECollisionChannel::ECC_WorldStatic;
         Clearance = 0.0f;
+        bUseHierarchicalRasterization = true;
+        bGatherPrimitivesPerLeaf = true;
+        TileSize = 10000.0f;
+        bRebuildDirtyAreasIncrementally = true;
+        OcclusionSource = ESVOOcclusionSource::PhysicsScene;
+        bGenerateClearanceField = false;
+        Resolution = ESVOResolution::Full;
+        bRasterizeLeavesLazily = false;
 
         CollisionQueryParameters.bFindInitialOverlaps = true;
         CollisionQueryParameters.bTraceComplex = false;
         CollisionQueryParameters.TraceTag = "SVONavigationRasterize";
     }
 
+    // Maximum number of collision channels, including CollisionChannel, whose occlusion is stored in the data
+    static constexpr int32 MaxCollisionChannelCount = 8;
+
+    // The collision channel first, then the additional ones, without duplicates.
+    // Only the physics scene can classify the primitives per channel, so the other occlusion sources only use the collision channel
+    TArray< TEnumAsByte< ECollisionChannel > > GetCollisionChannels() const;
+
     UPROPERTY( EditAnywhere, Category = "Generation" )
     TEnumAsByte< ECollisionChannel > CollisionChannel;
 
+    // Other channels rasterized by the same overlap queries as CollisionChannel. The octree is built from the union of all the channels, and the occluded sub nodes of each channel are stored in the data,
+    // so the query filters can choose which channels block their agents. Costs 8 bytes per leaf and per channel. Only supported by the PhysicsScene occlusion source
+    UPROPERTY( EditAnywhere, Category = "Generation", AdvancedDisplay )
+    TArray< TEnumAsByte< ECollisionChannel > > AdditionalCollisionChannels;
+
     UPROPERTY( EditAnywhere, Category = "Generation" )
     float Clearance;
 
+    // If set to true, the occlusion is tested from the root node down to the leaves, and the children of a node are only tested if that node is occluded.
+    // This drastically reduces the number of overlap tests in volumes which are mostly empty. The generated data is the same as when it's false.
+    UPROPERTY( EditAnywhere, Category = "Generation" )
+    uint8 bUseHierarchicalRasterization : 1;
+
+    // If set to true, a single overlap query is done against the physics scene for each leaf, and the sub nodes of the leaf are tested only against the primitives returned by that query.
+    // This replaces up to 64 scene queries per leaf by local tests against a few primitives. Has no effect when the occlusion source is the collision geometry snapshot.
+    UPROPERTY( EditAnywhere, Category = "Generation" )
+    uint8 bGatherPrimitivesPerLeaf : 1;
+
+    // Defines how the occlusion of the nodes is tested.
+    // CollisionGeometrySnapshot does not lock the physics scene during the generation, but does not support heightfields (landscapes)
+    // FinestNavigationData rasterizes the world only once for the smallest agent, and each bigger agent dilates and downsamples that occupancy instead.
+    // The agent radii should be powers of 2 of the smallest one, so the voxels of the different agents are aligned
+    UPROPERTY( EditAnywhere, Category = "Generation" )
+    ESVOOcclusionSource OcclusionSource;
+
+    // Volumes are split in cubic tiles of at most this size, which are rasterized in parallel in independent tasks. The actual size is a power of 2 of the leaf node size.
+    // Set to 0 to rasterize each volume in a single tile
+    UPROPERTY( EditAnywhere, Category = "Generation", meta = ( ClampMin = "0", UIMin = "0" ) )
+    float TileSize;
+
+    // If set to true, when some areas of a volume which was already generated become dirty, only the nodes around those areas are rasterized again, instead of the whole volume
+    UPROPERTY( EditAnywhere, Category = "Generation" )
+    uint8 bRebuildDirtyAreasIncrementally : 1;
+
+    // If set to true, the distance from each free node and sub node to the closest occluded sub node is stored in the data, quantized in half voxels.
+    // It is used by the query filters to keep the agents away from the obstacles, or to reject the nodes too close to them. Costs one byte per node and 64 bytes per leaf
+    UPROPERTY( EditAnywhere, Category = "Generation" )
+    uint8 bGenerateClearanceField : 1;
+
+    // Resolution of the data outside of the resolution modifier volumes. Where those volumes overlap, Full wins
+    UPROPERTY( EditAnywhere, Category = "Generation" )
+    ESVOResolution Resolution;
+
+    // If set to true, the generation only tests whether each leaf is occluded, and the sub nodes of an occluded leaf are rasterized the first time a query needs them.
+    // This removes most of the overlap tests of the generation, as the queries usually touch few leaves. The occlusion source is kept alive with the data to resolve the leaves.
+    // The leaves are all resolved when the data is saved, and when the clearance field is generated, which needs all of them
+    UPROPERTY( EditAnywhere, Category = "Generation" )
+    uint8 bRasterizeLeavesLazily : 1;
+
     FCollisionQueryParams CollisionQueryParameters;
 };
 
@@ -197,8 +284,17 @@ public:
     friend class FSVOVolumeNavigationData;
     friend class FSVOData;
 
+    FSVOLeafNodes() = default;
+    // The leaves of the copied data can be resolved by other threads during the copy
+    FSVOLeafNodes( const FSVOLeafNodes & other );
+    FSVOLeafNodes( FSVOLeafNodes && other ) = default;
+    FSVOLeafNodes & operator=( const FSVOLeafNodes & other ) = default;
+    FSVOLeafNodes & operator=( FSVOLeafNodes && other ) = default;
+
     const FSVOLeafNode & GetLeafNode( const LeafIndex leaf_index ) const;
     const TArray< FSVOLeafNode > & GetLeafNodes() const;
+    // False while the sub nodes of a leaf rasterized lazily are not rasterized. See FSVOVolumeNavigationData::GetLeafNode
+    bool IsLeafResolved( LeafIndex leaf_index ) const;
     float GetLeafNodeSize() const;
     float GetLeafNodeExtent() const;
     float GetLeafSubNodeSize() const;
@@ -212,11 +308,18 @@ private:
     void Initialize( float leaf_size );
     void Reset();
     void AllocateLeafNodes( int leaf_count );
-    void AddLeafNode( LeafIndex leaf_index, SubNodeIndex sub_node_index, bool is_occluded );
-    void AddEmptyLeafNode();
+    void ResolveLeaf( LeafIndex leaf_index, uint_fast64_t sub_nodes, const uint_fast64_t * channel_sub_nodes, int32 channel_count ) const;
 
     float LeafNodeSize;
     TArray< FSVOLeafNode > LeafNodes;
+    // 64 per leaf node, in morton order, when the clearance field is generated. See FSVOLayer::NodeClearances
+    TArray< uint8 > SubNodeClearances;
+    // One per leaf node when the leaves are rasterized lazily. Non zero while the sub nodes of the leaf are not rasterized, which are all considered occluded until then.
+    // The leaves are resolved by const queries from any thread, so these flags and the sub nodes of those leaves are accessed atomically
+    mutable TArray< int8 > UnresolvedLeaves;
+    // When the data has several collision channels, one mask of occluded sub nodes per leaf node and per channel, in the order of FSVOVolumeNavigationData::GetCollisionChannels.
+    // The sub nodes of each leaf node are the union of its masks
+    TArray< uint_fast64_t > ChannelSubNodes;
 };
 
 FORCEINLINE const FSVOLeafNode & FSVOLeafNodes::GetLeafNode( const LeafIndex leaf_index ) const
@@ -229,6 +332,11 @@ FORCEINLINE const TArray< FSVOLeafNode > & FSVOLeafNodes::GetLeafNodes() const
     return LeafNodes;
 }
 
+FORCEINLINE bool FSVOLeafNodes::IsLeafResolved( const LeafIndex leaf_index ) const
+{
+    return UnresolvedLeaves.Num() == 0 || FPlatformAtomics::AtomicRead( &UnresolvedLeaves[ leaf_index ] ) == 0;
+}
+
 FORCEINLINE float FSVOLeafNodes::GetLeafNodeSize() const
 {
     return LeafNodeSize;
@@ -258,6 +366,13 @@ FORCEINLINE FArchive & operator<<( FArchive & archive, FSVOLeafNodes & leaf_node
 {
     archive << leaf_nodes.LeafNodes;
     archive << leaf_nodes.LeafNodeSize;
+
+    // Only resolved leaves are saved
+    if ( archive.IsLoading() )
+    {
+        leaf_nodes.UnresolvedLeaves.Reset();
+    }
+
     return archive;
 }
 
@@ -266,16 +381,16 @@ class FSVOLayer
 public:
     friend FArchive & operator<<( FArchive & archive, FSVOLayer & layer );
     friend class FSVOVolumeNavigationData;
+    friend class FSVOData;
 
     FSVOLayer();
-    FSVOLayer( int max_node_count, float node_size );
+    explicit FSVOLayer( float node_size );
 
     const TArray< FSVONode > & GetNodes() const;
     int32 GetNodeCount() const;
     const FSVONode & GetNode( NodeIndex node_index ) const;
     float GetNodeSize() const;
     float GetNodeExtent() const;
-    uint32 GetMaxNodeCount() const;
 
     int GetAllocatedSize() const;
 
@@ -283,7 +398,8 @@ private:
     TArray< FSVONode > & GetNodes();
 
     TArray< FSVONode > Nodes;
-    int MaxNodeCount;
+    // One per node when the clearance field is generated. Distance from the center of the node to the closest occluded sub node, in half sub node sizes
+    TArray< uint8 > NodeClearances;
     float NodeSize;
 };
 
@@ -317,11 +433,6 @@ FORCEINLINE float FSVOLayer::GetNodeExtent() const
     return GetNodeSize() * 0.5f;
 }
 
-FORCEINLINE uint32 FSVOLayer::GetMaxNodeCount() const
-{
-    return MaxNodeCount;
-}
-
 FORCEINLINE FArchive & operator<<( FArchive & archive, FSVOLayer & layer )
 {
     archive << layer.Nodes;
@@ -343,21 +454,27 @@ public:
     const FSVOLeafNodes & GetLeafNodes() const;
     const FBox & GetNavigationBounds() const;
     const FBox & GetVolumeBounds() const;
+    // Number of nodes of the layer along each axis of the navigation bounds
+    FIntVector GetLayerNodeCounts( LayerIndex layer_index ) const;
     bool IsValid() const;
 
     void Reset();
     int GetAllocatedSize() const;
 
+    // The navigation bounds Initialize computes for the volume, so the space the generation tests can be known before the data exists.
+    // The volume bounds when the volume is too small to contain any data
+    static FBox ComputeNavigationBounds( float voxel_size, const FBox & volume_bounds );
+
 private:
     FSVOLayer & GetLayer( LayerIndex layer_index );
     FSVOLeafNodes & GetLeafNodes();
     bool Initialize( float voxel_size, const FBox & volume_bounds );
-    void AddBlockedNode( LayerIndex layer_index, NodeIndex node_index );
-    const TArray< NodeIndex > & GetLayerBlockedNodes( LayerIndex layer_index ) const;
+    // Removes the slack of the arrays of nodes once they are built
+    void Shrink();
 
-    TArray< TArray< NodeIndex > > BlockedNodes;
     TArray< FSVOLayer > Layers;
     FSVOLeafNodes LeafNodes;
+    // The roots of the octree are the nodes of the last layer. They are laid out in a grid which covers the volume bounds
     FBox NavigationBounds;
     // The bounds of the nav mesh bounds volume in the world
     FBox VolumeBounds;
@@ -409,11 +526,6 @@ FORCEINLINE bool FSVOData::IsValid() const
     return bIsValid && GetLayerCount() > 0;
 }
 
-FORCEINLINE const TArray< NodeIndex > & FSVOData::GetLayerBlockedNodes( const LayerIndex layer_index ) const
-{
-    return BlockedNodes[ layer_index ];
-}
-
 FORCEINLINE FArchive & operator<<( FArchive & archive, FSVOData & data )
 {
     archive << data.Layers;
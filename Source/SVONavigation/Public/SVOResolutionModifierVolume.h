@@ -0,0 +1,42 @@
+#pragma once
+
+#include "SVONavigationTypes.h"
+
+#include <CoreMinimal.h>
+#include <GameFramework/Volume.h>
+
+#include "SVOResolutionModifierVolume.generated.h"
+
+// Changes the resolution of the SVO navigation data generated inside its bounds, to only spend memory and generation time where details are needed
+UCLASS()
+class SVONAVIGATION_API ASVOResolutionModifierVolume final : public AVolume
+{
+    GENERATED_BODY()
+
+public:
+    ASVOResolutionModifierVolume();
+
+    ESVOResolution GetResolution() const;
+
+    void PostRegisterAllComponents() override;
+    void Destroyed() override;
+
+#if WITH_EDITOR
+    void PostEditMove( bool finished ) override;
+    void PostEditChangeProperty( FPropertyChangedEvent & property_changed_event ) override;
+#endif
+
+private:
+    // Makes the previous and the current bounds of the volume dirty, so the navigation data around them is generated again
+    void UpdateNavigation();
+
+    UPROPERTY( EditInstanceOnly, Category = "Navigation" )
+    ESVOResolution Resolution;
+
+    FBox LastBounds;
+};
+
+FORCEINLINE ESVOResolution ASVOResolutionModifierVolume::GetResolution() const
+{
+    return Resolution;
+}
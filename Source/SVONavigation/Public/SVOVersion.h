@@ -7,7 +7,12 @@ enum class ESVOVersion : uint8
     LeafNodeParent = 3,
     VolumeNavigationQueryFilter = 4,
     NavigationDataChunks = 5,
+    InputHash = 6,
+    ClearanceField = 7,
+    RootGrid = 8,
+    InvokerCells = 9,
+    CollisionChannels = 10,
 
-    MinCompatible = NavigationDataChunks,
-    Latest = NavigationDataChunks
+    MinCompatible = RootGrid,
+    Latest = CollisionChannels
 };
\ No newline at end of file
@@ -1,22 +1,74 @@
 #pragma once
 
+#include "SVOGenerationProgress.h"
 #include "SVONavigationTypes.h"
 
+#include <Misc/MemStack.h>
 #include <Templates/SubclassOf.h>
 
+class FSVOCollisionGeometrySnapshot;
+class FSVOVolumeNavigationData;
 class UNavigationQueryFilter;
+class UPrimitiveComponent;
 class USVONavigationQueryFilter;
 enum class ESVOVersion : uint8;
 
+struct FSVOResolutionModifier
+{
+    FBox Bounds;
+    ESVOResolution Resolution;
+};
+
 struct FSVOVolumeNavigationDataGenerationSettings
 {
     FSVOVolumeNavigationDataGenerationSettings();
 
     float VoxelExtent;
-    UWorld * World;
+    // Weak, as the data which rasterizes its leaves lazily keeps these settings after the generation, and can outlive the world
+    TWeakObjectPtr< UWorld > World;
     FSVODataGenerationSettings GenerationSettings;
+    // Only set when GenerationSettings.OcclusionSource is CollisionGeometrySnapshot
+    TSharedPtr< const FSVOCollisionGeometrySnapshot, ESPMode::ThreadSafe > CollisionGeometrySnapshot;
+    // Only set when GenerationSettings.OcclusionSource is FinestNavigationData. Copy of the data of the same volume generated for the smallest agent
+    TSharedPtr< const FSVOVolumeNavigationData, ESPMode::ThreadSafe > FinestNavigationData;
+    // When set to true, the generation stops as soon as possible, and the data is left invalid
+    FSVOGenerationCancellationToken CancellationToken;
+    // Optional. Updated while the data is generated
+    TSharedPtr< FSVOGenerationProgress, ESPMode::ThreadSafe > Progress;
+    // Hash of the inputs of the generation, stored in the generated data. 0 when unknown
+    uint64 InputHash;
+    // The resolution modifier volumes around the volume, gathered on the game thread
+    TArray< FSVOResolutionModifier > ResolutionModifiers;
+    // Sorted cells of the grid around the navigation invokers. When not empty, only the nodes overlapping them are generated
+    TArray< FBox > InvokerCells;
+};
+
+// Result of the rasterization of a tile of a volume. The tiles are rasterized independently, and then stitched together by FSVOVolumeNavigationData::FinishGeneration
+struct FSVOVolumeNavigationDataTile
+{
+    // Sorted morton codes of the occluded nodes of layer 1 inside the tile
+    TArray< MortonCode > LayerOneBlockedNodes;
+    // Sub nodes of the 8 leaves of each node of LayerOneBlockedNodes
+    TArray< uint_fast64_t > LeafSubNodes;
+    // Whether each of those leaves is occluded. An occluded leaf can have no occluded sub node
+    TArray< bool > OccludedLeaves;
+    // Whether the sub nodes of each of those leaves are still to be rasterized. Empty when the leaves are not rasterized lazily
+    TArray< bool > UnresolvedLeaves;
+    // The sub nodes of each of those leaves for each collision channel. Empty when the data has a single channel. See FSVOLeafNodes::ChannelSubNodes
+    TArray< uint_fast64_t > LeafChannelSubNodes;
+
+    int GetAllocatedSize() const;
 };
 
+FORCEINLINE int FSVOVolumeNavigationDataTile::GetAllocatedSize() const
+{
+    return LayerOneBlockedNodes.GetAllocatedSize() + LeafSubNodes.GetAllocatedSize() + OccludedLeaves.GetAllocatedSize() + UnresolvedLeaves.GetAllocatedSize() + LeafChannelSubNodes.GetAllocatedSize();
+}
+
+// Sorted morton codes of the nodes of a layer which have children, used to build the layer below.
+// They are only needed while the layers are built, so they live on the memory stack of the thread which builds them
+typedef TArray< MortonCode, TMemStackAllocator<> > FSVOLayerBlockedNodes;
+
 class SVONAVIGATION_API FSVOVolumeNavigationData
 {
 public:
@@ -36,41 +88,103 @@ public:
     const FBox & GetVolumeBounds() const;
     const FBox & GetNavigationBounds() const;
     const FSVOData & GetData() const;
+    uint64 GetInputHash() const;
     const FSVONode & GetNodeFromAddress( const FSVONodeAddress & address ) const;
+    // Rasterizes the sub nodes of the leaf first if it was rasterized lazily and they were not needed yet. Can be called from any thread
+    const FSVOLeafNode & GetLeafNode( LeafIndex leaf_index ) const;
+    // Copy of the leaf whose sub nodes are only the ones occluded by the channels of the mask
+    FSVOLeafNode GetLeafNodeForChannels( LeafIndex leaf_index, uint32 channel_mask ) const;
+    // The collision channels whose occlusion is stored in the data, in the order of the bits of the channel masks
+    const TArray< TEnumAsByte< ECollisionChannel > > & GetCollisionChannels() const;
+    // Mask of the channels of the data which are in the array. All the channels when the array is empty, or when none of its channels is in the data
+    uint32 GetCollisionChannelMask( const TArray< TEnumAsByte< ECollisionChannel > > & collision_channels ) const;
     TSubclassOf< USVONavigationQueryFilter > GetVolumeNavigationQueryFilter() const;
     void SetVolumeNavigationQueryFilter( TSubclassOf< USVONavigationQueryFilter > navigation_query_filter );
 
     FVector GetNodePositionFromAddress( const FSVONodeAddress & address, bool try_get_sub_node_position ) const;
     FVector GetNodePositionFromLayerAndMortonCode( LayerIndex layer_index, MortonCode morton_code ) const;
     FVector GetLeafNodePositionFromMortonCode( MortonCode morton_code ) const;
-    bool GetNodeAddressFromPosition( FSVONodeAddress & node_address, const FVector & position ) const;
-    void GetNodeNeighbors( TArray< FSVONodeAddress > & neighbors, const FSVONodeAddress & node_address ) const;
+    // The sub nodes of the leaves are only considered occluded by the channels of the mask
+    bool GetNodeAddressFromPosition( FSVONodeAddress & node_address, const FVector & position, uint32 channel_mask = MAX_uint32 ) const;
+    void GetNodeNeighbors( TArray< FSVONodeAddress > & neighbors, const FSVONodeAddress & node_address, uint32 channel_mask = MAX_uint32 ) const;
     float GetLayerRatio( LayerIndex layer_index ) const;
     float GetLayerInverseRatio( LayerIndex layer_index ) const;
     float GetNodeExtentFromNodeAddress( FSVONodeAddress node_address ) const;
     TOptional< FNavLocation > GetRandomPoint() const;
+    // Returns true if an occluded sub node overlaps the box. The space outside of the volume bounds and of the invoker cells is not rasterized, and is considered occluded.
+    // The leaves which are not rasterized yet are considered occluded when resolve_leaves is false
+    bool IsBoxOccluded( const FBox & box, bool resolve_leaves = true ) const;
+    // Distance from the center of the node, or of the sub node for the leaves, to the closest occluded sub node. Rounded down to half a sub node.
+    // MAX_flt when the clearance field was not generated
+    float GetNodeClearanceFromAddress( const FSVONodeAddress & node_address ) const;
 
     void GenerateNavigationData( const FBox & volume_bounds, const FSVOVolumeNavigationDataGenerationSettings & generation_settings );
+
+    // GenerateNavigationData split in steps, to rasterize the tiles in independent tasks.
+    // RasterizeTile can be called concurrently for different tiles once BeginGeneration returned true, and FinishGeneration must be called once all the tiles are rasterized
+    bool BeginGeneration( const FBox & volume_bounds, const FSVOVolumeNavigationDataGenerationSettings & generation_settings );
+    int32 GetTileCount() const;
+    void RasterizeTile( FSVOVolumeNavigationDataTile & tile, int32 tile_index ) const;
+    void FinishGeneration( const TArray< FSVOVolumeNavigationDataTile > & tiles );
+
+    // Rasterizes again only the nodes of layer 1 touched by the dirty bounds, in data which was already generated.
+    // The links are patched locally when only the leaves changed, and the layers are built again from the updated leaves otherwise
+    void UpdateNavigationData( const TArray< FBox > & dirty_bounds, const FSVOVolumeNavigationDataGenerationSettings & generation_settings );
+
     void Serialize( FArchive & archive, const ESVOVersion version );
     void Reset();
 
+    // Deterministic hash of everything the generated data depends on : the collision of the primitives which can affect the navigation around the volume, their transforms,
+    // the collision channel, the clearance, the voxel extent and the volume bounds. Must be called on the game thread
+    static uint64 ComputeInputHash( const UWorld & world, const FBox & volume_bounds, const FSVOVolumeNavigationDataGenerationSettings & generation_settings );
+
 private:
     int GetLayerCount() const;
+    bool IsGenerationCancelled() const;
+    FSVOGenerationProgress * GetGenerationProgress() const;
+    void EndGeneration();
     bool IsPositionOccluded( const FVector & position, float box_extent ) const;
-    void FirstPassRasterization();
-    void RasterizeLeaf( const FVector & node_position, const LeafIndex leaf_index );
-    void RasterizeInitialLayer( TMap< LeafIndex, MortonCode > & leaf_index_to_layer_one_node_index_map );
-    void RasterizeLayer( LayerIndex layer_index );
+    // Bit N is set when the box is occluded for the N-th collision channel
+    uint32 GetOccludedChannels( const FVector & position, float box_extent ) const;
+    bool IsNodeOccludedInBox( LayerIndex layer_index, NodeIndex node_index, const FBox & box, bool resolve_leaves ) const;
+    // primitive_channels receives the mask of the channels each primitive occludes
+    void GatherOccludingPrimitiveComponents( TArray< const UPrimitiveComponent * > & primitive_components, TArray< uint32 > & primitive_channels, const FVector & position, float box_extent ) const;
+    // False for the nodes outside of the volume bounds or of the invoker cells, which are neither rasterized nor traversed
+    bool IsNodeInVolumeBounds( LayerIndex layer_index, MortonCode morton_code ) const;
+    bool IsBoxInInvokerCells( const FBox & box ) const;
+    void HierarchicalRasterization( TArray< MortonCode > & layer_one_blocked_nodes, LayerIndex layer_index, MortonCode morton_code ) const;
+    // channel_sub_nodes receives the sub nodes of each collision channel when the data has several
+    bool RasterizeLeaf( const FVector & node_position, uint_fast64_t & sub_nodes, uint_fast64_t * channel_sub_nodes ) const;
+    void ResolveLeaf( LeafIndex leaf_index ) const;
+    void ResolveAllLeaves() const;
+    bool IsCoarseResolution( const FBox & node_bounds ) const;
+    void RasterizeTileLeaves( FSVOVolumeNavigationDataTile & tile ) const;
+    void GetLayerNodesInBounds( TArray< MortonCode > & morton_codes, LayerIndex layer_index, const TArray< FBox > & bounds ) const;
+    void RasterizeInitialLayer( const TArray< FSVOVolumeNavigationDataTile > & tiles, const FSVOLayerBlockedNodes & layer_one_blocked_nodes );
+    void RasterizeLayer( LayerIndex layer_index, const FSVOLayerBlockedNodes & layer_blocked_nodes, const FSVOLayerBlockedNodes & child_layer_blocked_nodes );
     int32 GetNodeIndexFromMortonCode( LayerIndex layer_index, MortonCode morton_code ) const;
     void BuildNeighborLinks( LayerIndex layer_index );
-    bool FindNeighborInDirection( FSVONodeAddress & node_address, const LayerIndex layer_index, const NodeIndex node_index, const NeighborDirection direction );
-    void GetLeafNeighbors( TArray< FSVONodeAddress > & neighbors, const FSVONodeAddress & leaf_address ) const;
+    // Only the clearance of the nodes close enough to the dirty bounds to be affected is computed again. The whole field when dirty_bounds is empty
+    void BuildClearanceField( const TArray< FBox > & dirty_bounds );
+    void BuildNodeNeighborLinks( LayerIndex layer_index, NodeIndex layer_node_index );
+    FSVONodeAddress FindNeighborInDirection( LayerIndex layer_index, NodeIndex node_index, NeighborDirection direction ) const;
+    void GetLeafNeighbors( TArray< FSVONodeAddress > & neighbors, const FSVONodeAddress & leaf_address, uint32 channel_mask ) const;
     void GetFreeNodesFromNodeAddress( FSVONodeAddress node_address, TArray< FSVONodeAddress > & free_nodes ) const;
-    void BuildParentLinkForLeafNodes( const TMap< LeafIndex, MortonCode > & leaf_index_to_parent_morton_code_map );
+    void BuildParentLinkForLeafNodes();
 
     FSVOVolumeNavigationDataGenerationSettings Settings;
     FBox VolumeBounds;
-    FSVOData SVOData;
+    // Shared by the copies of the data, so the generators and the navigation data don't copy the whole octree on the game thread.
+    // It is never modified once shared, except by the resolution of the lazy leaves : the generation and the updates work on a new instance
+    TSharedRef< FSVOData, ESPMode::ThreadSafe > SVOData = MakeShared< FSVOData, ESPMode::ThreadSafe >();
+    LayerIndex TileLayerIndex = 0;
+    // Sorted morton codes of the nodes of the tile layer which overlap the volume bounds. Only used during the generation
+    TArray< MortonCode > TileMortonCodes;
+    uint64 InputHash = 0;
+    // The invoker cells the data was generated in. Empty when the whole volume was generated
+    TArray< FBox > InvokerCells;
+    // Set from the generation settings, see FSVODataGenerationSettings::GetCollisionChannels. Empty in the data saved before the channels were stored
+    TArray< TEnumAsByte< ECollisionChannel > > CollisionChannels;
     TSubclassOf< USVONavigationQueryFilter > VolumeNavigationQueryFilter;
     bool bInNavigationDataChunk;
 };
@@ -85,6 +199,21 @@ FORCEINLINE void FSVOVolumeNavigationData::SetInNavigationDataChunk( const bool
     bInNavigationDataChunk = in_navigation_data_chunk;
 }
 
+FORCEINLINE bool FSVOVolumeNavigationData::IsGenerationCancelled() const
+{
+    return Settings.CancellationToken.IsValid() && Settings.CancellationToken->load( std::memory_order_relaxed );
+}
+
+FORCEINLINE FSVOGenerationProgress * FSVOVolumeNavigationData::GetGenerationProgress() const
+{
+    return Settings.Progress.Get();
+}
+
+FORCEINLINE int32 FSVOVolumeNavigationData::GetTileCount() const
+{
+    return TileMortonCodes.Num();
+}
+
 FORCEINLINE const FSVOVolumeNavigationDataGenerationSettings & FSVOVolumeNavigationData::GetDataGenerationSettings() const
 {
     return Settings;
@@ -97,19 +226,41 @@ FORCEINLINE const FBox & FSVOVolumeNavigationData::GetVolumeBounds() const
 
 FORCEINLINE const FBox & FSVOVolumeNavigationData::GetNavigationBounds() const
 {
-    return SVOData.GetNavigationBounds();
+    return SVOData->GetNavigationBounds();
 }
 
 FORCEINLINE const FSVOData & FSVOVolumeNavigationData::GetData() const
 {
-    return SVOData;
+    return *SVOData;
+}
+
+FORCEINLINE uint64 FSVOVolumeNavigationData::GetInputHash() const
+{
+    return InputHash;
 }
 
 FORCEINLINE const FSVONode & FSVOVolumeNavigationData::GetNodeFromAddress( const FSVONodeAddress & address ) const
 {
     return address.LayerIndex < 15
-               ? SVOData.GetLayer( address.LayerIndex ).GetNode( address.NodeIndex )
-               : SVOData.GetLastLayer().GetNode( 0 );
+               ? SVOData->GetLayer( address.LayerIndex ).GetNode( address.NodeIndex )
+               : SVOData->GetLastLayer().GetNode( 0 );
+}
+
+FORCEINLINE const FSVOLeafNode & FSVOVolumeNavigationData::GetLeafNode( const LeafIndex leaf_index ) const
+{
+    const auto & leaf_nodes = SVOData->GetLeafNodes();
+
+    if ( !leaf_nodes.IsLeafResolved( leaf_index ) )
+    {
+        ResolveLeaf( leaf_index );
+    }
+
+    return leaf_nodes.GetLeafNode( leaf_index );
+}
+
+FORCEINLINE const TArray< TEnumAsByte< ECollisionChannel > > & FSVOVolumeNavigationData::GetCollisionChannels() const
+{
+    return CollisionChannels;
 }
 
 FORCEINLINE TSubclassOf< USVONavigationQueryFilter > FSVOVolumeNavigationData::GetVolumeNavigationQueryFilter() const
@@ -124,5 +275,5 @@ FORCEINLINE void FSVOVolumeNavigationData::SetVolumeNavigationQueryFilter( TSubc
 
 FORCEINLINE int FSVOVolumeNavigationData::GetLayerCount() const
 {
-    return SVOData.GetLayerCount();
+    return SVOData->GetLayerCount();
 }
\ No newline at end of file
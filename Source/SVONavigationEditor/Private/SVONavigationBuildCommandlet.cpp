@@ -0,0 +1,229 @@
+#include "SVONavigationBuildCommandlet.h"
+
+#include "SVONavigationEditor/SVONavigationEditor.h"
+
+#include <SVONavigationData.h>
+
+#include <Editor.h>
+#include <Engine/LevelStreaming.h>
+#include <EngineUtils.h>
+#include <HAL/PlatformFileManager.h>
+#include <Misc/PackageName.h>
+#include <NavigationSystem.h>
+#include <UObject/SavePackage.h>
+
+namespace
+{
+	struct FSVONavigationBuildMemoryInfos
+	{
+		int32 VolumeCount = 0;
+		int64 NavigationDataSize = 0;
+	};
+
+	FSVONavigationBuildMemoryInfos GetNavigationDataMemoryInfos(UWorld& world)
+	{
+		FSVONavigationBuildMemoryInfos infos;
+
+		for (TActorIterator<ASVONavigationData> iterator(&world); iterator; ++iterator)
+		{
+			for (const auto& volume_navigation_data : iterator->GetVolumeNavigationData())
+			{
+				infos.VolumeCount++;
+				infos.NavigationDataSize += volume_navigation_data.GetData().GetAllocatedSize();
+			}
+		}
+
+		return infos;
+	}
+
+	double ToMegaBytes(const uint64 bytes)
+	{
+		return bytes / (1024.0 * 1024.0);
+	}
+}
+
+USVONavigationBuildCommandlet::USVONavigationBuildCommandlet()
+	: bSave(true)
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 USVONavigationBuildCommandlet::Main(const FString& params)
+{
+	FString map_name;
+	if (!FParse::Value(*params, TEXT("Map="), map_name))
+	{
+		UE_LOG(LogSVONavigationEditor, Error, TEXT("Missing -Map=<long package name of the map> argument"));
+		return 1;
+	}
+
+	int32 batch_size = 4;
+	FParse::Value(*params, TEXT("BatchSize="), batch_size);
+	batch_size = FMath::Max(batch_size, 1);
+	bSave = !FParse::Param(*params, TEXT("NoSave"));
+
+	const double start_time = FPlatformTime::Seconds();
+
+	UPackage* map_package = LoadPackage(nullptr, *map_name, LOAD_None);
+	UWorld* world = map_package != nullptr ? UWorld::FindWorldInPackage(map_package) : nullptr;
+
+	if (world == nullptr)
+	{
+		UE_LOG(LogSVONavigationEditor, Error, TEXT("Could not load the map %s"), *map_name);
+		return 1;
+	}
+
+	world->WorldType = EWorldType::Editor;
+	world->AddToRoot();
+
+	if (!world->bIsWorldInitialized)
+	{
+		// The physics scene is needed by the overlap queries of the generation
+		UWorld::InitializationValues initialization_values;
+		initialization_values
+			.RequiresHitProxies(false)
+			.ShouldSimulatePhysics(false)
+			.EnableTraceCollision(true)
+			.CreatePhysicsScene(true)
+			.CreateNavigation(false)
+			.CreateAISystem(false)
+			.AllowAudioPlayback(false);
+
+		world->InitWorld(initialization_values);
+		world->PersistentLevel->UpdateModelComponents();
+		world->UpdateWorldComponents(true, false);
+	}
+
+	FWorldContext& world_context = GEditor->GetEditorWorldContext(true);
+	world_context.SetCurrentWorld(world);
+	GWorld = world;
+
+	FNavigationSystem::AddNavigationSystemToWorld(*world, FNavigationSystemRunMode::EditorMode);
+
+	const auto all_streaming_levels = world->GetStreamingLevels();
+	const int32 batch_count = FMath::Max(1, FMath::DivideAndRoundUp(all_streaming_levels.Num(), batch_size));
+	bool success = true;
+
+	for (int32 batch_index = 0; batch_index < batch_count; ++batch_index)
+	{
+		TArray<ULevelStreaming*> batch_streaming_levels;
+
+		for (int32 level_index = batch_index * batch_size; level_index < FMath::Min((batch_index + 1) * batch_size, all_streaming_levels.Num()); ++level_index)
+		{
+			batch_streaming_levels.Add(all_streaming_levels[level_index]);
+		}
+
+		success &= BuildBatch(*world, batch_streaming_levels, batch_index, batch_count);
+	}
+
+	// The persistent level keeps the navigation data actors, and the data of the volumes which are not in a streaming level
+	if (bSave)
+	{
+		success &= SavePackage(*map_package);
+	}
+
+	const auto memory_stats = FPlatformMemory::GetStats();
+	UE_LOG(LogSVONavigationEditor, Display, TEXT("SVO navigation of %s built in %.2fs, %d batches of %d levels. Process memory : %.2f MB used, %.2f MB peak"),
+		*map_name,
+		FPlatformTime::Seconds() - start_time,
+		batch_count,
+		batch_size,
+		ToMegaBytes(memory_stats.UsedPhysical),
+		ToMegaBytes(memory_stats.PeakUsedPhysical));
+
+	world_context.SetCurrentWorld(nullptr);
+	GWorld = nullptr;
+	world->RemoveFromRoot();
+
+	return success ? 0 : 1;
+}
+
+bool USVONavigationBuildCommandlet::BuildBatch(UWorld& world, const TArray<ULevelStreaming*>& streaming_levels, const int32 batch_index, const int32 batch_count)
+{
+	const double start_time = FPlatformTime::Seconds();
+
+	for (ULevelStreaming* streaming_level : streaming_levels)
+	{
+		streaming_level->SetShouldBeLoaded(true);
+		streaming_level->SetShouldBeVisible(true);
+	}
+
+	world.FlushLevelStreaming(EFlushLevelStreamingType::Full);
+
+	const double load_time = FPlatformTime::Seconds() - start_time;
+
+	// Rebuilds all the volumes of the loaded levels. The volumes are generated in parallel, and each volume is split in tiles rasterized by all the workers.
+	// The navigation data chunks of the loaded levels are filled when the generation is finished
+	UNavigationSystemV1* navigation_system = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&world);
+
+	if (navigation_system == nullptr)
+	{
+		UE_LOG(LogSVONavigationEditor, Error, TEXT("No navigation system in the world %s"), *world.GetName());
+		return false;
+	}
+
+	navigation_system->Build();
+
+	const double build_time = FPlatformTime::Seconds() - start_time - load_time;
+	const auto memory_infos = GetNavigationDataMemoryInfos(world);
+	bool success = true;
+
+	if (bSave)
+	{
+		for (ULevelStreaming* streaming_level : streaming_levels)
+		{
+			if (const ULevel* level = streaming_level->GetLoadedLevel())
+			{
+				success &= SavePackage(*level->GetOutermost());
+			}
+		}
+	}
+
+	for (ULevelStreaming* streaming_level : streaming_levels)
+	{
+		streaming_level->SetShouldBeLoaded(false);
+		streaming_level->SetShouldBeVisible(false);
+	}
+
+	world.FlushLevelStreaming(EFlushLevelStreamingType::Full);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	const auto memory_stats = FPlatformMemory::GetStats();
+	UE_LOG(LogSVONavigationEditor, Display, TEXT("Batch %d / %d : %d levels loaded in %.2fs, built in %.2fs. %d volumes, %.2f MB of navigation data. Process memory : %.2f MB used, %.2f MB peak"),
+		batch_index + 1,
+		batch_count,
+		streaming_levels.Num(),
+		load_time,
+		build_time,
+		memory_infos.VolumeCount,
+		ToMegaBytes(memory_infos.NavigationDataSize),
+		ToMegaBytes(memory_stats.UsedPhysical),
+		ToMegaBytes(memory_stats.PeakUsedPhysical));
+
+	return success;
+}
+
+bool USVONavigationBuildCommandlet::SavePackage(UPackage& package) const
+{
+	const FString file_name = FPackageName::LongPackageNameToFilename(package.GetName(), FPackageName::GetMapPackageExtension());
+
+	// The files can be read only when they come from source control
+	FPlatformFileManager::Get().GetPlatformFile().SetReadOnly(*file_name, false);
+
+	FSavePackageArgs save_arguments;
+	save_arguments.TopLevelFlags = RF_Standalone;
+	save_arguments.Error = GError;
+
+	if (!UPackage::SavePackage(&package, UWorld::FindWorldInPackage(&package), *file_name, save_arguments))
+	{
+		UE_LOG(LogSVONavigationEditor, Error, TEXT("Could not save %s"), *file_name);
+		return false;
+	}
+
+	UE_LOG(LogSVONavigationEditor, Display, TEXT("Saved %s"), *file_name);
+	return true;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <Commandlets/Commandlet.h>
+#include <CoreMinimal.h>
+
+#include "SVONavigationBuildCommandlet.generated.h"
+
+class ULevelStreaming;
+
+/*
+ * Builds the SVO navigation data of a map without user interaction, for example on build machines.
+ * The streaming levels are loaded by batches, and the volumes of each batch are generated together before the levels of the batch are saved with their navigation data chunks.
+ *
+ * Usage : UnrealEditor-Cmd <Project> -run=SVONavigationBuild -Map=/Game/Maps/MyMap [-BatchSize=4] [-NoSave]
+ */
+UCLASS()
+class USVONavigationBuildCommandlet final : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USVONavigationBuildCommandlet();
+
+	int32 Main(const FString& params) override;
+
+private:
+	bool BuildBatch(UWorld& world, const TArray<ULevelStreaming*>& streaming_levels, int32 batch_index, int32 batch_count);
+	bool SavePackage(UPackage& package) const;
+
+	bool bSave;
+};
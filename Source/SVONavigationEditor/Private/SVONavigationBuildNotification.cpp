@@ -0,0 +1,112 @@
+#include "SVONavigationBuildNotification.h"
+
+#include <SVOGenerationProgress.h>
+#include <SVONavigationData.h>
+
+#include <Editor.h>
+#include <EngineUtils.h>
+#include <Framework/Notifications/NotificationManager.h>
+#include <Widgets/Notifications/SNotificationList.h>
+
+#define LOCTEXT_NAMESPACE "SVONavigationEditor"
+
+FSVONavigationBuildNotification::~FSVONavigationBuildNotification()
+{
+	if (const auto notification_item = NotificationItem.Pin())
+	{
+		notification_item->ExpireAndFadeout();
+	}
+}
+
+void FSVONavigationBuildNotification::Tick(float delta_time)
+{
+	UWorld* world = GEditor != nullptr ? GEditor->GetEditorWorldContext().World() : nullptr;
+
+	TArray<FSVOVolumeGenerationProgressInfo> progress_infos;
+
+	if (world != nullptr)
+	{
+		for (TActorIterator<ASVONavigationData> iterator(world); iterator; ++iterator)
+		{
+			iterator->GetGenerationProgress(progress_infos);
+		}
+	}
+
+	auto notification_item = NotificationItem.Pin();
+
+	if (progress_infos.Num() == 0)
+	{
+		if (notification_item.IsValid())
+		{
+			NotificationText = LOCTEXT("SVONavigationBuilt", "SVO navigation built");
+			notification_item->SetCompletionState(SNotificationItem::CS_Success);
+			notification_item->ExpireAndFadeout();
+			NotificationItem.Reset();
+		}
+
+		return;
+	}
+
+	int32 leaves_rasterized = 0;
+	int32 leaves_expected = 0;
+	float completion_ratio = 0.0f;
+	double estimated_remaining_time = -1.0;
+	ESVOGenerationStage stage = ESVOGenerationStage::Finished;
+
+	for (const auto& progress_info : progress_infos)
+	{
+		leaves_rasterized += progress_info.LeavesRasterized;
+		leaves_expected += progress_info.LeavesExpected;
+		completion_ratio += progress_info.GetCompletionRatio() / progress_infos.Num();
+		estimated_remaining_time = FMath::Max(estimated_remaining_time, progress_info.EstimatedRemainingTime);
+		// Show the least advanced stage
+		stage = FMath::Min(stage, progress_info.Stage);
+	}
+
+	FFormatNamedArguments arguments;
+	arguments.Add(TEXT("VolumeCount"), progress_infos.Num());
+	arguments.Add(TEXT("Stage"), FText::FromString(LexToString(stage)));
+	arguments.Add(TEXT("Percent"), FText::AsPercent(completion_ratio));
+	arguments.Add(TEXT("LeavesRasterized"), leaves_rasterized);
+	arguments.Add(TEXT("LeavesExpected"), leaves_expected);
+
+	if (estimated_remaining_time >= 0.0)
+	{
+		arguments.Add(TEXT("RemainingTime"), FText::AsTimespan(FTimespan::FromSeconds(FMath::CeilToDouble(estimated_remaining_time))));
+		NotificationText = FText::Format(LOCTEXT("SVONavigationBuildingWithEstimate", "Building SVO navigation ({VolumeCount} volumes) : {Percent}\n{Stage} - {LeavesRasterized} / {LeavesExpected} leaves\nAbout {RemainingTime} remaining"), arguments);
+	}
+	else
+	{
+		NotificationText = FText::Format(LOCTEXT("SVONavigationBuilding", "Building SVO navigation ({VolumeCount} volumes) : {Percent}\n{Stage} - {LeavesRasterized} / {LeavesExpected} leaves"), arguments);
+	}
+
+	if (!notification_item.IsValid())
+	{
+		FNotificationInfo notification_info(TAttribute<FText>::Create(TAttribute<FText>::FGetter::CreateRaw(this, &FSVONavigationBuildNotification::GetNotificationText)));
+		notification_info.bFireAndForget = false;
+		notification_info.bUseThrobber = true;
+		notification_info.FadeOutDuration = 1.0f;
+		notification_info.ExpireDuration = 0.0f;
+
+		notification_item = FSlateNotificationManager::Get().AddNotification(notification_info);
+
+		if (notification_item.IsValid())
+		{
+			notification_item->SetCompletionState(SNotificationItem::CS_Pending);
+		}
+
+		NotificationItem = notification_item;
+	}
+}
+
+TStatId FSVONavigationBuildNotification::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(FSVONavigationBuildNotification, STATGROUP_Tickables);
+}
+
+FText FSVONavigationBuildNotification::GetNotificationText() const
+{
+	return NotificationText;
+}
+
+#undef LOCTEXT_NAMESPACE
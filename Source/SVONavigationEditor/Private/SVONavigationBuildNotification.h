@@ -0,0 +1,28 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <TickableEditorObject.h>
+
+class SNotificationItem;
+
+// Shows a notification with the progress of the generation of the SVO navigation data of the editor world
+class FSVONavigationBuildNotification final : public FTickableEditorObject
+{
+public:
+	~FSVONavigationBuildNotification();
+
+	void Tick(float delta_time) override;
+	ETickableTickType GetTickableTickType() const override;
+	TStatId GetStatId() const override;
+
+private:
+	FText GetNotificationText() const;
+
+	TWeakPtr<SNotificationItem> NotificationItem;
+	FText NotificationText;
+};
+
+FORCEINLINE ETickableTickType FSVONavigationBuildNotification::GetTickableTickType() const
+{
+	return ETickableTickType::Always;
+}
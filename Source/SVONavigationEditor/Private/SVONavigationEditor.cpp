@@ -1,5 +1,7 @@
 #include "SVONavigationEditor/SVONavigationEditor.h"
 
+#include "SVONavigationBuildNotification.h"
+
 #include <PropertyEditorModule.h>
 
 IMPLEMENT_GAME_MODULE(FSVONavigationEditorModule, SVONavigationEditor);
@@ -11,11 +13,15 @@ DEFINE_LOG_CATEGORY(LogSVONavigationEditor)
 void FSVONavigationEditorModule::StartupModule()
 {
 	UE_LOG(LogSVONavigationEditor, Verbose, TEXT("SVONavigationEditor: Module Startup"));
+
+	BuildNotification = MakeShared<FSVONavigationBuildNotification>();
 }
 
 void FSVONavigationEditorModule::ShutdownModule()
 {
 	UE_LOG(LogSVONavigationEditor, Verbose, TEXT("SVONavigationEditor: Module Shutdown"));
+
+	BuildNotification.Reset();
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -19,7 +19,8 @@ public class SVONavigationEditor : ModuleRules
 			"EditorStyle", 
 			"UnrealEd", 
 			"GraphEditor", 
-			"BlueprintGraph" 
+			"BlueprintGraph",
+			"NavigationSystem"
 		});
 
 	    PrivateIncludePaths.AddRange( new string[] { 
@@ -5,9 +5,14 @@
 
 DECLARE_LOG_CATEGORY_EXTERN(LogSVONavigationEditor, Log, All)
 
+class FSVONavigationBuildNotification;
+
 class FSVONavigationEditorModule : public IModuleInterface
 {
 public:
 	void StartupModule() override;
 	void ShutdownModule() override;
+
+private:
+	TSharedPtr<FSVONavigationBuildNotification> BuildNotification;
 };
\ No newline at end of file